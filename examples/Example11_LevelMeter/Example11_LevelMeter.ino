@@ -0,0 +1,61 @@
+/**************************************************************************************
+ * This example draws a bouncing level meter across the display using the canvas
+ * functions. Segments are changed in displayRAM only and sent in one batch with
+ * updateDisplayDirty(), so only the bytes that changed go out over I2C.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach Qwiic Alphanumeric board to Red Board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+uint8_t level = 0;
+int8_t direction = 1;
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if display will acknowledge
+  if (display.begin() == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+}
+
+void loop() 
+{
+  //Two steps per digit, so 4 digits give levels 0 to 8
+  display.drawLevelMeter(0, 4, level);
+
+  //Mark the peak with the bottom segment of the last digit
+  display.setSegmentOnOff('D', 3, level == 8);
+
+  display.updateDisplayDirty();
+
+  if (level == 8)
+    direction = -1;
+  else if (level == 0)
+    direction = 1;
+  level += direction;
+
+  delay(20); //50Hz
+}
@@ -0,0 +1,71 @@
+/**************************************************************************************
+ * This example reads buttons wired to the key scan matrix of the HT16K33 and shows
+ * the number of the last key pressed.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach Qwiic Alphanumeric board to Red Board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * Wire buttons between the K and KS pins of the HT16K33 (see the datasheet).
+ * Optionally connect the INT pin to pin 2 so the keys are only read when one is down.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+#if !defined(ALPHA_KEY_SCAN)
+#error "Key scan is left out on AVR to save RAM, define ALPHA_KEY_SCAN in SparkFun_Alphanumeric_Display.h"
+#endif
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if display will acknowledge
+  if (display.begin() == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+
+  //Poll the INT flag register. Use display.enableKeyScan(0, 2) if INT is wired to pin 2.
+  display.enableKeyScan(0);
+
+  display.print("KEY");
+}
+
+void loop() 
+{
+  display.scanKeys();
+
+  alpha_key_event_t event;
+  while (display.readKeyEvent(&event) == true)
+  {
+    Serial.print("Key ");
+    Serial.print(event.key);
+    if (event.pressed == true)
+    {
+      Serial.println(" pressed");
+
+      char text[5];
+      snprintf(text, sizeof(text), "K %2d", event.key);
+      display.print(text);
+    }
+    else
+      Serial.println(" released");
+  }
+}
@@ -0,0 +1,87 @@
+/**************************************************************************************
+ * This example renders a counter on one core while the other core sends the frames
+ * to the displays. Works on ESP32 and RP2040 boards.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach the board to computer using a USB cable.
+ * Attach Qwiic Alphanumeric board to the board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * Attach a second Alphanumeric display using Qwiic cable.
+ *  Close address jumper A0 so that this display's address become 0x71.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+#if !defined(ALPHA_PIPELINE)
+#error "This example needs a dual core board such as an ESP32 or RP2040"
+#endif
+
+uint32_t counter = 0;
+volatile bool displayReady = false;
+
+#if defined(ARDUINO_ARCH_ESP32)
+//The transmit task runs on the core that isn't running loop()
+void transmitTask(void *parameter)
+{
+  while (1)
+  {
+    display.transmitFrame();
+    vTaskDelay(1);
+  }
+}
+#endif
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if displays will acknowledge
+  if (display.begin(0x70, 0x71) == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Displays acknowledged.");
+
+  display.beginPipeline();
+  displayReady = true;
+
+#if defined(ARDUINO_ARCH_ESP32)
+  xTaskCreatePinnedToCore(transmitTask, "alpha", 2048, NULL, 1, NULL, 1 - xPortGetCoreID());
+#endif
+}
+
+void loop() 
+{
+  //Render core: print() only draws into the frame buffer and hands it over. If the
+  //transmit core is still busy with the last frame it waits for it.
+  display.print(counter++);
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+//Transmit core
+void setup1()
+{
+  while (displayReady == false)
+    ;
+}
+
+void loop1()
+{
+  display.transmitFrame();
+}
+#endif
@@ -0,0 +1,67 @@
+/**************************************************************************************
+ * This example shows an HH:MM clock with a blinking colon. Only the digits that
+ * change and the colon byte are sent to the display each second.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach Qwiic Alphanumeric board to Red Board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+uint8_t hours = 12;
+uint8_t minutes = 0;
+uint8_t seconds = 0;
+unsigned long lastTick = 0;
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if display will acknowledge
+  if (display.begin() == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+
+  display.beginClock(0, false); //Blank the leading zero
+  display.setClockTime(hours, minutes);
+}
+
+void loop() 
+{
+  if (millis() - lastTick < 1000)
+    return;
+  lastTick += 1000;
+
+  display.toggleClockColon();
+
+  if (++seconds == 60)
+  {
+    seconds = 0;
+    if (++minutes == 60)
+    {
+      minutes = 0;
+      if (++hours == 13)
+        hours = 1;
+    }
+    display.setClockTime(hours, minutes);
+  }
+}
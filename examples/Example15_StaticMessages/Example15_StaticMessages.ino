@@ -0,0 +1,54 @@
+/**************************************************************************************
+ * This example shows fixed messages that are rendered when the sketch is compiled.
+ * Each message is stored in flash as display RAM, so showing one is a single write
+ * with no character lookup.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach Qwiic Alphanumeric board to Red Board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+//Name, number of displays and text of each message
+ALPHA_IMAGE(openMessage, 1, "OPEN");
+ALPHA_IMAGE(calMessage, 1, "CAL ");
+ALPHA_IMAGE(errorMessage, 1, "ERR.");
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if display will acknowledge
+  if (display.begin() == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+}
+
+void loop() 
+{
+  display.displayImage(openMessage);
+  delay(1000);
+  display.displayImage(calMessage);
+  delay(1000);
+  display.displayImage(errorMessage);
+  delay(1000);
+}
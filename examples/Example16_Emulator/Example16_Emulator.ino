@@ -0,0 +1,86 @@
+/**************************************************************************************
+ * This example runs the library against a software model of the HT16K33, so no
+ * display is needed. A few strings are printed, the display RAM of the model is
+ * checked against known good images and the digits are drawn on the serial monitor
+ * along with the time the transactions would have taken on the bus.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ *  No display is needed. Open the serial monitor at 115200 baud.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+#include <SparkFun_Alphanumeric_Emulator.h>
+HT16K33 display;
+HT16K33Emulator emulator;
+
+//Display RAM expected for each test
+const uint8_t printGolden[16] = {0xBB, 0x00, 0x0F, 0x00, 0x27, 0x00, 0x4A, 0x00, 0x09, 0x00, 0x21, 0x00, 0x09, 0x00, 0x00, 0x00};
+const uint8_t printCharGolden[16] = {0x04, 0x00, 0x21, 0x00, 0x09, 0x00, 0xE0, 0x00, 0x31, 0x00, 0x49, 0x00, 0xB0, 0x00, 0x00, 0x00};
+const uint8_t defineCharGolden[16] = {0x33, 0x01, 0x00, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00};
+
+void check(const char *name, const uint8_t *golden)
+{
+  Serial.print(name);
+  if (memcmp(emulator.getRAM(DEFAULT_ADDRESS), golden, 16) == 0)
+    Serial.println(": pass");
+  else
+    Serial.println(": FAIL");
+
+  emulator.render(Serial);
+
+  Serial.print("Bus time: ");
+  Serial.print(emulator.getBusMicros());
+  Serial.print("us in ");
+  Serial.print(emulator.getTransactions());
+  Serial.println(" transactions");
+  Serial.println();
+  emulator.resetCounters();
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+
+  emulator.addDisplay(DEFAULT_ADDRESS);
+  emulator.setBusClock(100000);
+  display.attachEmulator(&emulator); //Must be before begin()
+
+  if (display.begin() == false)
+  {
+    Serial.println("Emulated display did not acknowledge! Freezing.");
+    while(1);
+  }
+  emulator.resetCounters();
+
+  display.print("AB12");
+  check("print", printGolden);
+
+  display.clear();
+  display.printChar('W', 0);
+  display.printChar('X', 1);
+  display.printChar('7', 2);
+  display.printChar('%', 3);
+  display.updateDisplay();
+  check("printChar", printCharGolden);
+
+  display.defineChar('A', SEG_A | SEG_D | SEG_G | SEG_I);
+  display.print("A.A:");
+  check("defineChar", defineCharGolden);
+}
+
+void loop() 
+{
+}
@@ -0,0 +1,86 @@
+/**************************************************************************************
+ * This example splits one display into zones that refresh at different rates. The
+ * first two digits count tenths of a second at 10Hz, the last two show a status
+ * code that only changes now and then. updateZones() sends whatever is due in as
+ * few transactions as it can, so a zone that doesn't change costs nothing.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach Qwiic Alphanumeric board to Red Board using Qwiic cable. 
+ *  Don't close any of the address jumpers so that it defaults to address 0x70.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+#if !defined(ALPHA_ZONES)
+#error "Zones are left out on AVR to save RAM, define ALPHA_ZONES in SparkFun_Alphanumeric_Display.h"
+#endif
+
+#define TICKER_ZONE 0
+#define STATUS_ZONE 1
+
+uint8_t tenths = 0;
+uint8_t status = 0;
+unsigned long lastStatus = 0;
+uint16_t lateRefreshes = 0;
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  //check if display will acknowledge
+  if (display.begin() == false)
+  {
+    Serial.println("Device did not acknowledge! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+
+  display.defineZone(TICKER_ZONE, 0, 2, 100); //Digits 0 and 1, at most every 100ms
+  display.defineZone(STATUS_ZONE, 2, 2);      //Digits 2 and 3, shown as soon as they change
+  display.setZoneText(STATUS_ZONE, "OK");
+}
+
+void loop() 
+{
+  //The ticker is given new text all the time, it is only drawn when due
+  char text[3];
+  text[0] = '0' + (millis() / 1000) % 10;
+  text[1] = '0' + (millis() / 100) % 10;
+  text[2] = '\0';
+  display.setZoneText(TICKER_ZONE, text);
+
+  if (millis() - lastStatus > 3000)
+  {
+    lastStatus = millis();
+    status = (status + 1) % 10;
+    char code[3] = {'E', (char)('0' + status), '\0'};
+    display.setZoneText(STATUS_ZONE, code);
+  }
+
+  display.updateZones();
+
+  //Report each late refresh once
+  uint16_t misses = display.getZoneDeadlineMisses(TICKER_ZONE);
+  if (misses != lateRefreshes)
+  {
+    lateRefreshes = misses;
+    Serial.print("Ticker refresh was late, ");
+    Serial.print(misses);
+    Serial.println(" times so far");
+  }
+}
@@ -0,0 +1,63 @@
+/**************************************************************************************
+ * This example finds the displays on the bus by itself and keeps them running when
+ * one is unplugged or swapped. beginAuto() uses whichever addresses answer, and
+ * checkHotPlug() looks at one display at a time so the check barely loads the bus.
+ * A display that comes back is given its text, brightness and settings again
+ * without touching the others.
+ * 
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ * 
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ * 
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ * 
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ * Attach one or more Qwiic Alphanumeric boards to Red Board using Qwiic cables. 
+ *  Give each board a different address with the address jumpers.
+ * 
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+HT16K33 display;
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+  Wire.begin(); //Join I2C bus
+
+  uint8_t addresses[8];
+  uint8_t found = display.scanForDisplays(addresses, 8);
+  Serial.print("Displays found:");
+  for (uint8_t i = 0; i < found && i < 8; i++)
+  {
+    Serial.print(" 0x");
+    Serial.print(addresses[i], HEX);
+  }
+  Serial.println();
+
+  if (display.beginAuto() == false)
+  {
+    Serial.println("No display acknowledged! Freezing.");
+    while(1);
+  }
+  Serial.println("Display acknowledged.");
+
+  display.print("PLUG");
+  display.enableHotPlug(250); //Check one display every 250ms
+}
+
+void loop() 
+{
+  uint8_t restored = display.checkHotPlug();
+  if (restored != 0)
+  {
+    Serial.print("Restored displays 0b");
+    Serial.println(restored, BIN);
+  }
+}
@@ -0,0 +1,126 @@
+/**************************************************************************************
+ * This example measures the library. Fixed workloads run through the public functions
+ * against the HT16K33 software model, which counts every transaction and byte that
+ * would go over the bus. One CSV line is printed per workload so runs from before and
+ * after a change can be compared with a spreadsheet or a diff.
+ *
+ * Columns: workload, frames, transactions, bytes, bus time (us) and CPU time (us),
+ * each for the whole run, then transactions, bytes and CPU time per frame.
+ * CPU time includes the model itself but no I2C waiting, compare it between runs on
+ * the same board.
+ *
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ *
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ *
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ *
+ * Hardware Connections:
+ * Attach Red Board to computer using micro-B USB cable.
+ *  No display is needed. Open the serial monitor at 115200 baud.
+ *
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+#include <SparkFun_Alphanumeric_Emulator.h>
+HT16K33 display;
+HT16K33Emulator emulator;
+
+#define FRAMES 200 //Frames in each workload, keep it fixed so runs can be compared
+
+//16 digit print loop, every digit changes each frame
+void printFrame(uint16_t frame)
+{
+  char text[17];
+  for (uint8_t i = 0; i < 16; i++)
+    text[i] = '0' + (frame + i) % 10;
+  text[16] = '\0';
+  display.print(text);
+}
+
+//Marquee like Example9, the text is printed again once it has scrolled off
+void marqueeFrame(uint16_t frame)
+{
+  if (frame % 16 == 0)
+    display.print("GET MILK AND EGG");
+  else
+    display.shiftLeft();
+}
+
+//Blinking colons, as on a clock
+void colonFrame(uint16_t frame)
+{
+  if (frame & 1)
+    display.colonOn();
+  else
+    display.colonOff();
+}
+
+//Text drawn from user defined characters, one of which is redefined every frame
+void defineCharFrame(uint16_t frame)
+{
+  display.defineChar('a' + frame % 8, SEG_A | SEG_D | (frame & 0x0FFF));
+  display.print((frame & 1) ? "abcdefghabcdefgh" : "hgfedcbahgfedcba");
+}
+
+void runWorkload(const char *name, void (*drawFrame)(uint16_t frame))
+{
+  display.clear();
+  emulator.resetCounters();
+
+  uint32_t startTime = micros();
+  for (uint16_t frame = 0; frame < FRAMES; frame++)
+    drawFrame(frame);
+  uint32_t cpuMicros = micros() - startTime;
+
+  Serial.print(name);
+  Serial.print(',');
+  Serial.print(FRAMES);
+  Serial.print(',');
+  Serial.print(emulator.getTransactions());
+  Serial.print(',');
+  Serial.print(emulator.getBytes());
+  Serial.print(',');
+  Serial.print(emulator.getBusMicros());
+  Serial.print(',');
+  Serial.print(cpuMicros);
+  Serial.print(',');
+  Serial.print((float)emulator.getTransactions() / FRAMES, 2);
+  Serial.print(',');
+  Serial.print((float)emulator.getBytes() / FRAMES, 2);
+  Serial.print(',');
+  Serial.println((float)cpuMicros / FRAMES, 2);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+
+  emulator.addDisplay(0x70);
+  emulator.addDisplay(0x71);
+  emulator.addDisplay(0x72);
+  emulator.addDisplay(0x73);
+  emulator.setBusClock(400000);
+  display.attachEmulator(&emulator); //Must be before begin()
+
+  if (display.begin(0x70, 0x71, 0x72, 0x73) == false)
+  {
+    Serial.println("Emulated displays did not acknowledge! Freezing.");
+    while(1);
+  }
+
+  Serial.println("workload,frames,transactions,bytes,bus_us,cpu_us,transactions_per_frame,bytes_per_frame,cpu_us_per_frame");
+  runWorkload("print16", printFrame);
+  runWorkload("marquee", marqueeFrame);
+  runWorkload("colon", colonFrame);
+  runWorkload("defineChar", defineCharFrame);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,121 @@
+/**************************************************************************************
+ * This example measures the frame rate gained by the dual core pipeline. The same
+ * 16 digit frames are drawn twice against the HT16K33 software model, first with
+ * rendering and sending on one core, then with the pipeline sending from the other
+ * core. The model takes as long as the real bus for each transaction, so no display
+ * is needed. Works on ESP32 and RP2040 boards.
+ *
+ * The gain depends on how much of a frame is rendering and how much is bus time, a
+ * faster bus clock leaves more of the frame to rendering and makes the gain larger.
+ *
+ * SparkFun Electronics
+ * Original Creation Date: October 18, 2026
+ *
+ * SparkFun labored with love to create this code. Feel like supporting open source hardware?
+ * Buy a board from SparkFun! https://www.sparkfun.com/products/16391
+ *
+ * This code is Lemonadeware; if you see me (or any other SparkFun employee) at the
+ * local, and you've found our code helpful, please buy us a round!
+ *
+ * Hardware Connections:
+ * Attach the board to computer using a USB cable.
+ *  No display is needed. Open the serial monitor at 115200 baud.
+ *
+ * Distributed as-is; no warranty is given.
+ *****************************************************************************************/
+#include <Wire.h>
+
+#include <SparkFun_Alphanumeric_Display.h>  //Click here to get the library: http://librarymanager/All#Alphanumeric_Display by SparkFun
+#include <SparkFun_Alphanumeric_Emulator.h>
+HT16K33 display;
+HT16K33Emulator emulator;
+
+#if !defined(ALPHA_PIPELINE)
+#error "This example needs a dual core board such as an ESP32 or RP2040"
+#endif
+
+#define FRAMES 500 //Frames drawn in each run
+
+volatile bool transmitting = false;
+
+#if defined(ARDUINO_ARCH_ESP32)
+//The transmit task runs on the core that isn't running loop()
+void transmitTask(void *parameter)
+{
+  while (1)
+  {
+    uint32_t sent = display.getPipelineStats().framesTransmitted;
+    if (transmitting == true)
+      display.transmitFrame();
+    if (display.getPipelineStats().framesTransmitted == sent)
+      vTaskDelay(1); //Nothing was waiting, let the other tasks on this core run
+  }
+}
+#endif
+
+//Draw the frames and return the average time of each in microseconds
+uint32_t drawFrames()
+{
+  char text[17];
+  uint32_t startTime = micros();
+  for (uint16_t frame = 0; frame < FRAMES; frame++)
+  {
+    for (uint8_t i = 0; i < 16; i++)
+      text[i] = 'A' + (frame + i * 7) % 26;
+    text[16] = '\0';
+    display.print(text);
+  }
+  return ((micros() - startTime) / FRAMES);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Qwiic Alphanumeric examples");
+
+  emulator.addDisplay(0x70);
+  emulator.addDisplay(0x71);
+  emulator.addDisplay(0x72);
+  emulator.addDisplay(0x73);
+  emulator.setBusClock(400000);
+  display.attachEmulator(&emulator); //Must be before begin()
+
+  if (display.begin(0x70, 0x71, 0x72, 0x73) == false)
+  {
+    Serial.println("Emulated displays did not acknowledge! Freezing.");
+    while(1);
+  }
+
+  emulator.setRealTime(true); //Each transaction now takes its bus time
+
+#if defined(ARDUINO_ARCH_ESP32)
+  xTaskCreatePinnedToCore(transmitTask, "alpha", 2048, NULL, 1, NULL, 1 - xPortGetCoreID());
+#endif
+
+  uint32_t singleCore = drawFrames();
+
+  display.beginPipeline();
+  transmitting = true;
+  uint32_t pipelined = drawFrames();
+
+  Serial.print("One core: ");
+  Serial.print(singleCore);
+  Serial.println("us per frame");
+  Serial.print("Pipeline: ");
+  Serial.print(pipelined);
+  Serial.println("us per frame");
+  Serial.print("Speedup: ");
+  Serial.println((float)singleCore / pipelined, 2);
+}
+
+void loop()
+{
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+//Transmit core
+void loop1()
+{
+  if (transmitting == true)
+    display.transmitFrame();
+}
+#endif
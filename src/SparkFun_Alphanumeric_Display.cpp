@@ -30,120 +30,81 @@ Distributed as-is; no warranty is given.
 ******************************************************************************/
 
 #include <SparkFun_Alphanumeric_Display.h>
+#include <SparkFun_Alphanumeric_Emulator.h>
 
-/*--------------------------- Character Map ----------------------------------*/
-#define SFE_ALPHANUM_UNKNOWN_CHAR 95
-
-//This is the lookup table of segments for various characters
-//For AVR architecture, use PROGMEM
 #if defined(ARDUINO_ARCH_AVR)
-#include <avr/pgmspace.h>
-static const uint16_t PROGMEM alphanumeric_segs[96]{
+#include <util/atomic.h>
+//Single core and no caches, only the compiler has to be stopped from reordering
+#define ALPHA_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
 #else
-static const uint16_t alphanumeric_segs[96]{
+#define ALPHA_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+#if defined(__GCC_ATOMIC_CHAR_LOCK_FREE) && (__GCC_ATOMIC_CHAR_LOCK_FREE == 2)
+#define ALPHA_QUEUE_LOCK_FREE
+#elif defined(ARDUINO_ARCH_RP2040)
+#include <pico/critical_section.h>
+//The M0+ has no byte compare and swap and masking interrupts only stops the calling
+//core, a hardware spin lock keeps out producers on the other core as well
+static critical_section_t commandQueueLock;
 #endif
-	//nmlkjihgfedcba
-	0b00000000000000, //' ' (space)
-	0b00001000001000, //'!'  - added to map
-	0b00001000000010, //'"' - added to map
- 	0b1001101001110,  //'#'
-	0b1001101101101,  //'$'
-	0b10010000100100, //'%'
-	0b110011011001,   //'&'
-	0b1000000000,	  //'''
-	0b111001,         //'('
-	0b1111,           //')'
-	0b11111010000000, //'*'
-	0b1001101000000,  //'+'
-	0b10000000000000, //','
-	0b101000000,	  //'-'
-	0b00000000000000, //'.' - changed to blank
-	0b10010000000000, //'/'
-	0b111111,         //'0'
-	0b10000000110,	  //'1'
-	0b101011011,	  //'2'
-	0b101001111,	  //'3'
-	0b101100110,	  //'4'
-	0b101101101,	  //'5'
-	0b101111101,	  //'6'
-	0b1010000000001,  //'7'
-	0b101111111,	  //'8'
-	0b101100111,	  //'9'
-	0b00000000000000, //':' - changed to blank
-	0b10001000000000, //';'
-	0b110000000000,   //'<'
-	0b101001000,	  //'='
-	0b01000010000000, //'>'
-    0b01000100000011, //'?' - Added to map
-	0b00001100111011, //'@' - Added to map
-	0b101110111,	  //'A'
-	0b1001100001111,  //'B'
-	0b111001,         //'C'
-	0b1001000001111,  //'D'
-	0b101111001,	  //'E'
-	0b101110001,	  //'F'
-	0b100111101,	  //'G'
-	0b101110110,	  //'H'
-	0b1001000001001,  //'I'
-	0b11110,          //'J'
-	0b110001110000,   //'K'
-	0b111000,         //'L'
-	0b10010110110,	  //'M'
-	0b100010110110,   //'N'
-	0b111111,         //'O'
-	0b101110011,	  //'P'
-	0b100000111111,   //'Q'
-	0b100101110011,   //'R'
-	0b110001101,	  //'S'
-	0b1001000000001,  //'T'
-	0b111110,         //'U'
-	0b10010000110000, //'V'
-	0b10100000110110, //'W'
-	0b10110010000000, //'X'
-	0b1010010000000,  //'Y'
-	0b10010000001001, //'Z'
-	0b111001,         //'['
-	0b100010000000,   //'\'
-	0b1111,           //']'
-    0b10100000000000, //'^' - Added to map
-	0b1000,			  //'_'
-	0b10000000,		  //'`'
-	0b101011111,	  //'a'
-	0b100001111000,   //'b'
-	0b101011000,	  //'c'
-	0b10000100001110, //'d'
-	0b1111001,        //'e'
-	0b1110001,        //'f'
-	0b110001111,	  //'g'
-	0b101110100,	  //'h'
-	0b1000000000000,  //'i'
-	0b1110,           //'j'
-	0b1111000000000,  //'k'
-	0b1001000000000,  //'l'
-	0b1000101010100,  //'m'
-	0b100001010000,   //'n'
-	0b101011100,	  //'o'
-	0b10001110001,	  //'p'
-	0b100101100011,   //'q'
-	0b1010000,        //'r'
-	0b110001101,	  //'s'
-	0b1111000,        //'t'
-	0b11100,          //'u'
-	0b10000000010000, //'v'
-	0b10100000010100, //'w'
-	0b10110010000000, //'x'
-	0b1100001110,	  //'y'
-	0b10010000001001, //'z'
-	0b10000011001001, //'{'
-	0b1001000000000,  //'|'
-	0b110100001001,   //'}'
-	0b00000101010010, //'~' - Added to map
-	0b11111111111111, //Unknown character (DEL or RUBOUT)
+
+//Convert the result of endTransmission() to an error code
+static alpha_status_t i2cResultToStatus(uint8_t result)
+{
+	switch (result)
+	{
+	case 0:
+		return ALPHA_SUCCESS;
+	case 2:
+		return ALPHA_ERROR_NACK_ADDRESS;
+	case 3:
+		return ALPHA_ERROR_NACK_DATA;
+	case 5:
+		return ALPHA_ERROR_TIMEOUT; //Only on cores with an I2C timeout
+	}
+	return ALPHA_ERROR_BUS;
+}
+
+//Opened at the top of a call that uses the bus. Every transaction made while one is open
+//gets what is left of the latency budget counted from the outermost call, so a call of
+//several transactions can't wait on the bus for more than one budget. The sketch's own
+//I2C timeout goes back on the port when the outermost call returns.
+class HT16K33::CallBudget
+{
+public:
+	CallBudget(HT16K33 *display) : owner(display)
+	{
+		if (owner->callDepth++ == 0)
+			owner->callStartTime = micros();
+	}
+
+	~CallBudget()
+	{
+		if (--owner->callDepth == 0)
+			owner->restoreWireTimeout();
+	}
+
+private:
+	HT16K33 *owner;
 };
 
 /*--------------------------- Device Status----------------------------------*/
 
 bool HT16K33::begin(uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addressRightCenter, uint8_t addressRight, TwoWire &wirePort)
+{
+	return (startDisplays(addressLeft, addressLeftCenter, addressRightCenter, addressRight, wirePort, NULL, 0));
+}
+
+//Start the displays showing a state from saveState(). Nothing is cleared, so the displays
+//don't flash on a restart. If the state doesn't fit these displays this is the same as begin().
+bool HT16K33::beginWithState(const uint8_t *state, size_t stateSize, uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addressRightCenter, uint8_t addressRight, TwoWire &wirePort)
+{
+	return (startDisplays(addressLeft, addressLeftCenter, addressRightCenter, addressRight, wirePort, state, stateSize));
+}
+
+bool HT16K33::startDisplays(uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addressRightCenter, uint8_t addressRight,
+							TwoWire &wirePort, const uint8_t *state, size_t stateSize)
 {
 
 	_deviceAddressLeft = addressLeft;				//grab the address of the alphanumeric
@@ -164,34 +125,56 @@ bool HT16K33::begin(uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addr
 
 	_i2cPort = &wirePort; //Remember the user's setting
 
-	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	powerStateChange = millis();
+	lastActivity = powerStateChange;
+
+	bus.faultedDisplays = 0;
+
+	//All displays share one latency budget so a missing display can't stall begin() for long.
+	//Only the probes count, the setup traffic that follows goes to displays known to be there.
 	{
-		if (isConnected(i) == false)
+		CallBudget budget(this);
+
+		for (uint8_t i = 0; i < numberOfDisplays; i++)
 		{
-			//Serial.println("Failed isConnected()");
-			return false;
+			alpha_status_t status = probeDisplay(i);
+			if (status != ALPHA_SUCCESS)
+			{
+				//Serial.println("Failed isConnected()");
+				setError(status);
+				return false;
+			}
+			// if (checkDeviceID(i) == false)
+			// {
+			// 	Serial.println(i);
+			// 	Serial.println("Hello, I've failed checkDeviceID()");
+			// 	return false;
+			// }
 		}
-		// if (checkDeviceID(i) == false)
-		// {
-		// 	Serial.println(i);
-		// 	Serial.println("Hello, I've failed checkDeviceID()");
-		// 	return false;
-		// }
 	}
 
-	if (initialize() == false)
+	if (state != NULL && loadState(state, stateSize) == true)
 	{
-		//Serial.println("Failed initialize()");
-		return false;
+		//Warm start: clock, RAM, dimming and display setup in one pass per display
+		if (restoreDisplays((1 << numberOfDisplays) - 1) == false)
+			return false;
 	}
-
-	if (clear() == false) //Clear all displays
+	else
 	{
-		//Serial.println("Failed clear()");
-		return false;
+		if (initialize() == false)
+		{
+			//Serial.println("Failed initialize()");
+			return false;
+		}
+
+		if (clear() == false) //Clear all displays
+		{
+			//Serial.println("Failed clear()");
+			return false;
+		}
 	}
 
-	displayContent[4 * 4] = '\0'; //Terminate the array because we are doing direct prints
+	initCommandQueue();
 
 	return true;
 }
@@ -200,13 +183,29 @@ bool HT16K33::begin(uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addr
 //The Holtek IC sometimes fails to respond. This attempts multiple times before giving up.
 bool HT16K33::isConnected(uint8_t displayNumber)
 {
-	uint8_t triesBeforeGiveup = 20;
+	CallBudget budget(this);
+
+	alpha_status_t status = probeDisplay(displayNumber);
+	if (status != ALPHA_SUCCESS)
+	{
+		setError(status);
+		return false;
+	}
+	return true;
+}
+
+//Retry the display address until it acknowledges, the retry budget is used up or
+//the latency budget of the call runs out
+alpha_status_t HT16K33::probeDisplay(uint8_t displayNumber)
+{
+	alpha_status_t status = ALPHA_ERROR_NACK_ADDRESS;
 
-	for (uint8_t x = 0; x < triesBeforeGiveup; x++)
+	for (uint8_t x = 0; x < retryBudget; x++)
 	{
-		_i2cPort->beginTransmission(lookUpDisplayAddress(displayNumber));
-		if (_i2cPort->endTransmission() == 0)
+		uint8_t result = probeAddress(lookUpDisplayAddress(displayNumber));
+		if (result == 0)
 		{
+			recordResult(displayNumber, ALPHA_SUCCESS);
 			// if (x > 0)
 			// {
 			// 	Serial.print("isConnect successful");
@@ -215,16 +214,31 @@ bool HT16K33::isConnected(uint8_t displayNumber)
 			// 	Serial.print(" tries");
 			// 	Serial.println();
 			// }
-			return true;
+			return ALPHA_SUCCESS;
 		}
+		status = i2cResultToStatus(result);
 
-		delay(1);
+		uint32_t wait = remainingBudget();
+		if (wait == 0)
+		{
+			status = ALPHA_ERROR_TIMEOUT;
+			break;
+		}
+
+		//Wait before the next try, but never past the budget
+		if (wait > 1000)
+			wait = 1000;
+		delayMicroseconds(wait);
 	}
-	return false;
+
+	recordResult(displayNumber, status);
+	return status;
 }
 
 bool HT16K33::initialize()
 {
+	CallBudget budget(this);
+
 	//Turn on system clock of all displays
 	if (enableSystemClock() == false)
 	{
@@ -280,6 +294,7 @@ bool HT16K33::initialize()
 
 bool HT16K33::enableSystemClock()
 {
+	CallBudget budget(this);
 	bool status = true;
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
@@ -291,10 +306,11 @@ bool HT16K33::enableSystemClock()
 
 bool HT16K33::disableSystemClock()
 {
+	CallBudget budget(this);
 	bool status = true;
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (enableSystemClockSingle(i) == false)
+		if (disableSystemClockSingle(i) == false)
 			status = false;
 	}
 	return status;
@@ -305,7 +321,11 @@ bool HT16K33::enableSystemClockSingle(uint8_t displayNumber)
 	uint8_t dataToWrite = ALPHA_CMD_SYSTEM_SETUP | 1; //Enable system clock
 
 	bool status = writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite);
-	delay(1); //Allow display to start
+
+	//Don't block here, the oscillator only has to be running once the display is turned on
+	clockStartTime = micros();
+	clockSettling |= 1 << displayNumber;
+	clockStopped &= ~(1 << displayNumber);
 	return (status);
 }
 
@@ -313,9 +333,24 @@ bool HT16K33::disableSystemClockSingle(uint8_t displayNumber)
 {
 	uint8_t dataToWrite = ALPHA_CMD_SYSTEM_SETUP | 0; //Standby mode
 
+	clockStopped |= 1 << displayNumber;
 	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
 }
 
+//Wait out whatever is left of the oscillator start-up time. RAM and setup writes
+//sent since enableSystemClockSingle() count towards it, so this is usually free.
+void HT16K33::waitForClockSettle()
+{
+	if (clockSettling == 0)
+		return;
+
+	uint32_t elapsed = micros() - clockStartTime;
+	if (elapsed < ALPHA_CLOCK_SETTLE_US)
+		delayMicroseconds(ALPHA_CLOCK_SETTLE_US - elapsed);
+
+	clockSettling = 0;
+}
+
 uint8_t HT16K33::lookUpDisplayAddress(uint8_t displayNumber)
 {
 	switch (displayNumber)
@@ -337,409 +372,2458 @@ uint8_t HT16K33::lookUpDisplayAddress(uint8_t displayNumber)
 	return 0; //We shouldn't get here
 }
 
-/*-------------------------- Display configuration functions ---------------------------*/
+/*------------------------------- Saved state ---------------------------------*/
 
-bool HT16K33::clear()
+//A saved state is, in order: magic, version, number of displays, display setup (blink
+//and on/off), dimming of each display, RAM of each display, the segments (low byte first)
+//and character of each digit, digit position, number of defined characters then the character and segments (low
+//byte first) of each, and a Fletcher-16 checksum of everything before it.
+static uint16_t stateChecksum(const uint8_t *data, size_t size)
 {
-	//Clear the displayRAM array
-	for (uint8_t i = 0; i < 16 * numberOfDisplays; i++)
-		displayRAM[i] = 0;
-
-	digitPosition = 0;
-
-	return (updateDisplay());
-}
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
 
-//Duty valid between 1 and 16
-bool HT16K33::setBrightness(uint8_t duty)
-{
-	bool status = true;
-	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	for (size_t i = 0; i < size; i++)
 	{
-		if (setBrightnessSingle(i, duty) == false)
-			status = false;
+		sum1 = (sum1 + data[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
 	}
-	return status;
+	return (sum2 << 8) | sum1;
 }
 
-bool HT16K33::setBrightnessSingle(uint8_t displayNumber, uint8_t duty)
+//Bytes needed by saveState() for the current displays and defined characters
+size_t HT16K33::getStateSize()
 {
-	if (duty > 15)
-		duty = 15; //Error check
+	size_t definedChars = 0;
+	for (struct CharDef *pDefChar = pCharDefList; pDefChar != NULL; pDefChar = pDefChar->next)
+		definedChars++;
 
-	uint8_t dataToWrite = ALPHA_CMD_DIMMING_SETUP | duty;
-	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
+	return (4 + numberOfDisplays * (1 + 16 + 4 * 3) + 2 + definedChars * 3 + 2);
 }
 
-//Parameter "rate" in Hz
-//Valid options for "rate" are defined by datasheet: 2, 1, or 0.5 Hz
-//Any other input to this function will result in steady alphanumeric display
-bool HT16K33::setBlinkRate(float rate)
+bool HT16K33::saveState(uint8_t *buffer, size_t bufferSize)
 {
-	bool status = true;
+	size_t stateSize = getStateSize();
+	if (buffer == NULL || bufferSize < stateSize)
+		return false;
+
+	uint8_t *data = buffer;
+	*data++ = ALPHA_STATE_MAGIC;
+	*data++ = ALPHA_STATE_VERSION;
+	*data++ = numberOfDisplays;
+	*data++ = (blinkRate << 1) | displayOnOff;
+
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
+		*data++ = brightness[i];
+
+	memcpy(data, displayRAM, 16 * numberOfDisplays);
+	data += 16 * numberOfDisplays;
+	for (uint8_t digit = 0; digit < 4 * numberOfDisplays; digit++)
 	{
-		if (setBlinkRateSingle(i, rate) == false)
-			status = false;
+		*data++ = displayDigits[digit].segments & 0xFF;
+		*data++ = displayDigits[digit].segments >> 8;
+		*data++ = displayDigits[digit].character;
 	}
-	return status;
-}
 
-bool HT16K33::setBlinkRateSingle(uint8_t displayNumber, float rate)
-{
-	if (rate == 2)
+	*data++ = digitPosition;
+
+	uint8_t *definedChars = data++;
+	*definedChars = 0;
+	for (struct CharDef *pDefChar = pCharDefList; pDefChar != NULL; pDefChar = pDefChar->next)
 	{
-		blinkRate = ALPHA_BLINK_RATE_2HZ;
+		*data++ = pDefChar->position + '!' - 1;
+		*data++ = pDefChar->segments & 0xFF;
+		*data++ = pDefChar->segments >> 8;
+		(*definedChars)++;
 	}
-	else if (rate == 1)
+
+	uint16_t checksum = stateChecksum(buffer, data - buffer);
+	*data++ = checksum & 0xFF;
+	*data++ = checksum >> 8;
+
+	return true;
+}
+
+//Check a saved state and copy it into the class, nothing is sent
+bool HT16K33::loadState(const uint8_t *state, size_t stateSize)
+{
+	size_t fixedSize = 4 + numberOfDisplays * (1 + 16 + 4 * 3) + 2 + 2;
+	if (state == NULL || stateSize < fixedSize)
+		return false;
+
+	if (state[0] != ALPHA_STATE_MAGIC || state[1] != ALPHA_STATE_VERSION || state[2] != numberOfDisplays)
+		return false;
+
+	const uint8_t *data = state + 4 + numberOfDisplays * (1 + 16 + 4 * 3) + 1;
+	uint8_t definedChars = *data++;
+	size_t savedSize = fixedSize + definedChars * 3;
+	if (stateSize < savedSize)
+		return false;
+
+	uint16_t checksum = state[savedSize - 2] | (state[savedSize - 1] << 8);
+	if (stateChecksum(state, savedSize - 2) != checksum)
+		return false;
+
+	//State is good, apply it
+	for (uint8_t x = 0; x < definedChars; x++)
 	{
-		blinkRate = ALPHA_BLINK_RATE_1HZ;
+		defineChar(data[0], data[1] | (data[2] << 8));
+		data += 3;
 	}
-	else if (rate == 0.5)
+
+	data = state + 3;
+	blinkRate = (*data >> 1) & 0b11;
+	displayOnOff = *data++ & 0b1;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		blinkRate = ALPHA_BLINK_RATE_0_5HZ;
+		uint8_t duty = *data++;
+		brightness[i] = (duty > 15) ? 15 : duty;
 	}
-	//default to no blink
-	else
+
+	memcpy(displayRAM, data, 16 * numberOfDisplays);
+	data += 16 * numberOfDisplays;
+	for (uint8_t digit = 0; digit < 4 * numberOfDisplays; digit++)
 	{
-		blinkRate = ALPHA_BLINK_RATE_NOBLINK;
+		displayDigits[digit].segments = data[0] | (data[1] << 8);
+		displayDigits[digit].character = data[2];
+		data += 3;
 	}
 
-	uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
-	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
+	digitPosition = (*data > 4 * numberOfDisplays) ? 4 * numberOfDisplays : *data;
+	streamDigit = (digitPosition > 0) ? digitPosition - 1 : 0;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+		dirtyRAM[i] = 0;
+
+	return true;
 }
 
-bool HT16K33::displayOnSingle(uint8_t displayNumber)
+//Show a state from saveState(). The displays must be the same ones it was saved from.
+bool HT16K33::restoreState(const uint8_t *state, size_t stateSize)
 {
-	return setDisplayOnOff(displayNumber, true);
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+		return false; //Only the transmit core may use the bus
+#endif
+
+	CallBudget budget(this);
+
+	if (loadState(state, stateSize) == false)
+		return false;
+
+	if (standby == true)
+		return true; //Sent when the displays wake up
+
+	noteActivity();
+
+	return (restoreDisplays((1 << numberOfDisplays) - 1));
 }
-bool HT16K33::displayOffSingle(uint8_t displayNumber)
+
+/*------------------------------- Idle manager ---------------------------------*/
+
+//Blank the displays and stop their oscillators after timeoutMillis without updates.
+//A timeout of 0 turns the idle manager off.
+void HT16K33::setIdleTimeout(uint32_t timeoutMillis)
 {
-	return setDisplayOnOff(displayNumber, false);
+	idleTimeout = timeoutMillis;
+	lastActivity = millis();
 }
 
-//Set or clear the display on/off bit of a given display number
-bool HT16K33::setDisplayOnOff(uint8_t displayNumber, bool turnOnDisplay)
+//Call regularly from loop(). Puts the displays into standby once the idle timeout has passed.
+bool HT16K33::checkIdle()
 {
-	if (turnOnDisplay == true)
-		displayOnOff = ALPHA_DISPLAY_ON;
-	else
-		displayOnOff = ALPHA_DISPLAY_OFF;
+	if (idleTimeout == 0 || standby == true)
+		return true;
 
-	uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
-	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
-}
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+		return true; //Only the transmit core may use the bus
+#endif
 
-//Turn on/off the entire display
-bool HT16K33::displayOn()
-{
-	bool status = true;
+	if (millis() - lastActivity < idleTimeout)
+		return true;
 
-	displayOnOff = ALPHA_DISPLAY_ON;
+	CallBudget budget(this);
+	return (enterStandby());
+}
 
-	for (uint8_t i = 0; i < numberOfDisplays; i++)
-	{
-		if (displayOnSingle(i) == false)
-			status = false;
-	}
+//Record an update. If the displays are in standby they are woken up first.
+void HT16K33::noteActivity()
+{
+	lastActivity = millis();
 
-	return status;
+	if (standby == true)
+		wake();
 }
 
-bool HT16K33::displayOff()
+//Turn off the displays and put the HT16K33s into oscillator standby. displayRAM and
+//the setup registers are kept so wake() can restore them. Key scanning needs the
+//oscillator, so displays with key scan enabled are only blanked.
+bool HT16K33::enterStandby()
 {
-	bool status = true;
+	if (standby == true)
+		return true;
 
-	displayOnOff = ALPHA_DISPLAY_OFF;
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+		return false; //Only the transmit core may use the bus
+#endif
+
+	CallBudget budget(this);
+	bool status = true;
 
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (displayOffSingle(i) == false)
+		//Blank first, then stop the oscillator
+		uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | ALPHA_DISPLAY_OFF;
+		if (writeRAM(lookUpDisplayAddress(i), dataToWrite) == false)
+			status = false;
+
+#if defined(ALPHA_KEY_SCAN)
+		if ((keyScanDisplays >> i) & 0b1)
+			continue; //Keys are still read in standby
+#endif
+
+		if (disableSystemClockSingle(i) == false)
 			status = false;
 	}
 
+	updatePowerTime();
+	standby = true;
+	powerStats.standbyCount++;
+
 	return status;
 }
 
-bool HT16K33::decimalOnSingle(uint8_t displayNumber)
+//Restart the oscillators and restore RAM, dimming and display setup of every display.
+//The RAM writes cover most of the oscillator start-up time.
+bool HT16K33::wake()
 {
-	return setDecimalOnOff(displayNumber, true);
-}
+	if (standby == false)
+		return true;
 
-bool HT16K33::decimalOffSingle(uint8_t displayNumber)
-{
-	return setDecimalOnOff(displayNumber, false);
-}
+	CallBudget budget(this);
+	uint32_t startTime = micros();
 
-bool HT16K33::setDecimalOnOff(uint8_t displayNumber, bool turnOnDecimal)
-{
-	uint8_t adr = 0x03;
-	uint8_t dat;
+	updatePowerTime();
+	standby = false; //Clear first, the writes below count as activity
+	lastActivity = millis();
 
-	if (turnOnDecimal == true)
-	{
-		decimalOnOff = ALPHA_DECIMAL_ON;
-		dat = 0x01;
-	}
-	else
-	{
-		decimalOnOff = ALPHA_DECIMAL_OFF;
-		dat = 0x00;
-	}
+	bool status = restoreDisplays((1 << numberOfDisplays) - 1);
 
-	displayRAM[adr + displayNumber * 16] = displayRAM[adr + displayNumber * 16] | dat;
-	return (updateDisplay());
+	uint32_t wakeMicros = micros() - startTime;
+	if (wakeMicros > 0xFFFF)
+		wakeMicros = 0xFFFF;
+	powerStats.lastWakeMicros = wakeMicros;
+	if (wakeMicros > powerStats.maxWakeMicros)
+		powerStats.maxWakeMicros = wakeMicros;
+
+	return status;
 }
 
-//Turn on/off the entire display
-bool HT16K33::decimalOn()
+//Bring a set of displays back to the cached state: start the oscillators, send RAM and
+//dimming, then turn them on. The RAM writes cover most of the oscillator start-up time.
+bool HT16K33::restoreDisplays(uint8_t displayMask)
 {
+	CallBudget budget(this);
 	bool status = true;
 
-	decimalOnOff = ALPHA_DECIMAL_ON;
-
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (decimalOnSingle(i) == false)
+		if (((displayMask >> i) & 0b1) && enableSystemClockSingle(i) == false)
 			status = false;
 	}
 
-	//Serial.println(status);
-	return status;
-}
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (((displayMask >> i) & 0b1) == 0)
+			continue;
 
-bool HT16K33::decimalOff()
-{
-	bool status = true;
+		busState()->staleDimming |= 1 << i; //Sent along with the RAM
+		if (updateDisplayRAM(i, 0xFFFF) == false)
+			status = false;
+	}
 
-	decimalOnOff = ALPHA_DECIMAL_OFF;
+	waitForClockSettle();
 
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (decimalOffSingle(i) == false)
+		if (((displayMask >> i) & 0b1) == 0)
+			continue;
+
+		uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
+		if (writeRAM(lookUpDisplayAddress(i), dataToWrite) == false)
 			status = false;
 	}
+
 	return status;
 }
 
-bool HT16K33::colonOnSingle(uint8_t displayNumber)
+bool HT16K33::isStandby()
 {
-	return setColonOnOff(displayNumber, true);
+	return standby;
 }
 
-bool HT16K33::colonOffSingle(uint8_t displayNumber)
+//Add the time since the last standby entry or wake up to the matching counter
+void HT16K33::updatePowerTime()
 {
-	return setColonOnOff(displayNumber, false);
+	uint32_t now = millis();
+
+	if (standby == true)
+		powerStats.standbyMillis += now - powerStateChange;
+	else
+		powerStats.activeMillis += now - powerStateChange;
+
+	powerStateChange = now;
 }
 
-bool HT16K33::setColonOnOff(uint8_t displayNumber, bool turnOnColon)
+alpha_power_stats_t HT16K33::getPowerStats()
 {
-	uint8_t adr = 0x01;
-	uint8_t dat;
-
-	if (turnOnColon == true)
-	{
-		colonOnOff = ALPHA_COLON_ON;
-		dat = 0x01;
-	}
-	else
-	{
-		colonOnOff = ALPHA_COLON_OFF;
-		dat = 0x00;
-	}
+	updatePowerTime();
+	return powerStats;
+}
 
-	displayRAM[adr + displayNumber * 16] = displayRAM[adr + displayNumber * 16] | dat;
-	return (updateDisplay());
+void HT16K33::resetPowerStats()
+{
+	powerStats.standbyCount = 0;
+	powerStats.standbyMillis = 0;
+	powerStats.activeMillis = 0;
+	powerStats.lastWakeMicros = 0;
+	powerStats.maxWakeMicros = 0;
+	powerStateChange = millis();
 }
 
-bool HT16K33::colonOn()
+/*------------------------------- Power budget ---------------------------------*/
+
+//Lit bits in each nibble
+static const uint8_t nibbleBitCount[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+//Segments lit by the 16 RAM bytes of a display
+static uint8_t countLitSegments(const uint8_t *ram)
 {
-	bool status = true;
+	uint8_t lit = 0;
+	for (uint8_t i = 0; i < 16; i++)
+		lit += nibbleBitCount[ram[i] & 0x0F] + nibbleBitCount[ram[i] >> 4];
+	return lit;
+}
 
-	colonOnOff = ALPHA_COLON_ON;
+//Limit the current of each display. Before a frame goes out its lit segments are counted,
+//and if the frame would draw more than milliampsPerDisplay the dimming register of that
+//display is lowered. The brightness set with setBrightness() comes back as the frame
+//gets lighter. A budget of 0 turns the limit off.
+bool HT16K33::setPowerBudget(uint16_t milliampsPerDisplay, uint16_t microampsPerSegment)
+{
+	powerBudget = milliampsPerDisplay;
+	segmentMicroamps = microampsPerSegment;
 
+	CallBudget budget(this);
+	bool status = true;
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (colonOnSingle(i) == false)
+		//Frames aren't counted while the budget is off
+		busState()->litSegments[i] = countLitSegments(displayRAM + i * 16);
+
+		uint8_t duty = limitBrightness(i);
+		if (duty != busState()->appliedBrightness[i] && writeDimming(i, duty) == false)
 			status = false;
 	}
 	return status;
 }
 
-bool HT16K33::colonOff()
+//Estimated current of the last frame sent in microamps, for one display or for all of
+//them with ALPHA_NO_DISPLAY. Frames are only counted while the power budget is on,
+//otherwise the segments are counted here from displayRAM.
+uint32_t HT16K33::getEstimatedCurrent(uint8_t displayNumber)
 {
-	bool status = true;
-
-	colonOnOff = ALPHA_COLON_OFF;
+	if (standby == true || displayOnOff == ALPHA_DISPLAY_OFF)
+		return 0;
 
+	uint32_t current = 0;
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (colonOffSingle(i) == false)
-			status = false;
+		if (displayNumber != ALPHA_NO_DISPLAY && displayNumber != i)
+			continue;
+		uint8_t lit = (powerBudget == 0) ? countLitSegments(displayRAM + i * 16) : bus.litSegments[i];
+		//Each dimming step adds 1/16 duty
+		current += (uint32_t)lit * segmentMicroamps * (bus.appliedBrightness[i] + 1) / 16;
 	}
+	return current;
+}
+
+//Dimming register as last written, lower than the brightness set when the budget is limiting
+uint8_t HT16K33::getAppliedBrightness(uint8_t displayNumber)
+{
+	if (displayNumber >= 4)
+		return 0;
+	return bus.appliedBrightness[displayNumber];
+}
+
+//Highest dimming at or below the set brightness that keeps the last counted frame
+//within the budget. Never lower than 1/16 duty, the display can't go dimmer.
+uint8_t HT16K33::limitBrightness(uint8_t displayNumber)
+{
+	uint8_t duty = brightness[displayNumber];
+	uint8_t lit = busState()->litSegments[displayNumber];
+	if (powerBudget == 0 || lit == 0)
+		return duty;
+
+	uint32_t frameMicroamps = (uint32_t)lit * segmentMicroamps;
+	uint32_t steps = (uint32_t)powerBudget * 1000 * 16 / frameMicroamps; //Duty in 1/16ths the budget allows
+	if (steps == 0)
+		return 0;
+	if (steps - 1 < duty)
+		duty = steps - 1;
+	return duty;
+}
+
+bool HT16K33::writeDimming(uint8_t displayNumber, uint8_t duty)
+{
+	uint8_t dataToWrite = ALPHA_CMD_DIMMING_SETUP | duty;
+	if (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite) == false)
+		return false;
+
+	alpha_bus_state_t *state = busState();
+	state->appliedBrightness[displayNumber] = duty;
+	state->staleDimming &= ~(1 << displayNumber);
+	return true;
+}
+
+/*-------------------------- Latency limits and errors ---------------------------*/
+
+//Limit the time a call may spend waiting on a display that doesn't respond, and the number of
+//connection attempts. The budget covers the whole call, once it is used up the transactions
+//left are skipped. On cores with an I2C timeout (WIRE_HAS_TIMEOUT) each transaction's bus
+//timeout is cut to what is left of the budget. A budget of 0 turns the limit off.
+void HT16K33::setLatencyBudget(uint32_t budgetMicros, uint8_t retries)
+{
+	if (retries == 0)
+		retries = 1; //Error check
+
+	latencyBudget = budgetMicros;
+	retryBudget = retries;
+}
+
+//The Wire library can't report its timeout, so a sketch that uses its own sets it here
+//instead of on the port. It is put back on the port after every call of this library.
+//Without it the port is left at ALPHA_DEFAULT_WIRE_TIMEOUT. No effect on cores without
+//an I2C timeout.
+void HT16K33::setWireTimeout(uint32_t timeoutMicros, bool resetOnTimeout)
+{
+#if defined(WIRE_HAS_TIMEOUT)
+	wireTimeout = timeoutMicros;
+	wireTimeoutReset = resetOnTimeout;
+	wireTimeoutChanged = true;
+
+	if (callDepth == 0)
+		restoreWireTimeout();
+#endif
+}
+
+//Microseconds left of the latency budget of the call in progress
+uint32_t HT16K33::remainingBudget()
+{
+	if (latencyBudget == 0)
+		return 0xFFFFFFFF; //No limit
+
+	uint32_t elapsed = micros() - callStartTime;
+	if (elapsed >= latencyBudget)
+		return 0;
+	return (latencyBudget - elapsed);
+}
+
+//Check the budget before a transaction and cut the I2C timeout to what is left of it.
+//Returns false if nothing is left, the transaction must then be skipped.
+bool HT16K33::startTransaction()
+{
+	uint32_t remaining = remainingBudget();
+	if (remaining == 0)
+		return false;
+
+#if defined(WIRE_HAS_TIMEOUT)
+	if (emulator == NULL && _i2cPort != NULL && remaining != 0xFFFFFFFF)
+	{
+		if (wireTimeout != 0 && wireTimeout < remaining)
+			remaining = wireTimeout; //The sketch's own limit is shorter
+		_i2cPort->setWireTimeout(remaining, true);
+		wireTimeoutChanged = true;
+	}
+#endif
+	return true;
+}
+
+//Put the sketch's I2C timeout back on the port
+void HT16K33::restoreWireTimeout()
+{
+#if defined(WIRE_HAS_TIMEOUT)
+	if (wireTimeoutChanged == false || _i2cPort == NULL)
+		return;
+
+	_i2cPort->setWireTimeout(wireTimeout, wireTimeoutReset);
+	wireTimeoutChanged = false;
+#endif
+}
+
+//Return the last error since the previous call and clear it
+alpha_status_t HT16K33::getLastError()
+{
+	alpha_status_t error = bus.lastError;
+	bus.lastError = ALPHA_SUCCESS;
+	return error;
+}
+
+void HT16K33::setError(alpha_status_t error)
+{
+	if (error != ALPHA_SUCCESS)
+		busState()->lastError = error;
+}
+
+//Where bus results are recorded. While the pipeline runs only the transmit core uses the
+//bus, and it records into its own copy.
+alpha_bus_state_t *HT16K33::busState()
+{
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+		return &transmitBus;
+#endif
+	return &bus;
+}
+
+//Convert an I2C address back to a display number
+uint8_t HT16K33::lookUpDisplayNumber(uint8_t address)
+{
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (address == lookUpDisplayAddress(i))
+			return i;
+	}
+	return ALPHA_NO_DISPLAY;
+}
+
+/*------------------------------ Per display faults -------------------------------*/
+
+//Bitmask of the displays whose last transaction failed, bit 0 is the left display
+uint8_t HT16K33::getFaultedDisplays()
+{
+	return bus.faultedDisplays;
+}
+
+//Last error seen on a display, cleared when it recovers
+alpha_status_t HT16K33::getDisplayError(uint8_t displayNumber)
+{
+	if (displayNumber > 3)
+		return ALPHA_SUCCESS;
+	return bus.displayError[displayNumber];
+}
+
+//When on, nothing is sent to a faulted display until recoverDisplays() finds it again.
+//One dead display then no longer costs a failed transaction on every update.
+void HT16K33::setFaultIsolation(bool skipFaultedDisplays)
+{
+	faultIsolation = skipFaultedDisplays;
+}
+
+//Probe each faulted display once. Displays that answer are restored from the cached
+//RAM and setup registers. Returns a bitmask of the displays that recovered.
+uint8_t HT16K33::recoverDisplays()
+{
+	CallBudget budget(this);
+	alpha_bus_state_t *state = busState();
+	uint8_t recovered = 0;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (((state->faultedDisplays >> i) & 0b1) == 0)
+			continue;
+
+		if (probeAddress(lookUpDisplayAddress(i)) == 0)
+		{
+			state->faultedDisplays &= ~(1 << i);
+			state->displayError[i] = ALPHA_SUCCESS;
+			recovered |= 1 << i;
+		}
+	}
+
+	if (recovered != 0)
+		restoreDisplays(recovered);
+
+	return recovered;
+}
+
+/*--------------------------- Discovery and hot-plug ----------------------------*/
+
+//Probe each address from 0x70 to 0x77 once and list the ones that answer, lowest
+//first. Returns the number of displays found, which may be more than maxAddresses.
+uint8_t HT16K33::scanForDisplays(uint8_t *addresses, uint8_t maxAddresses, TwoWire &wirePort)
+{
+	_i2cPort = &wirePort;
+
+	//Each probe is a call of its own with the short scan budget
+	uint32_t budget = latencyBudget;
+	latencyBudget = ALPHA_SCAN_TIMEOUT_US;
+
+	uint8_t found = 0;
+	for (uint8_t address = ALPHA_SCAN_FIRST_ADDRESS; address <= ALPHA_SCAN_LAST_ADDRESS; address++)
+	{
+		if (probeAddress(address) != 0)
+			continue;
+
+		if (addresses != NULL && found < maxAddresses)
+			addresses[found] = address;
+		found++;
+	}
+
+	latencyBudget = budget;
+
+	return found;
+}
+
+//begin() with the first four displays found by scanForDisplays(), left to right in
+//address order
+bool HT16K33::beginAuto(TwoWire &wirePort)
+{
+	uint8_t addresses[4] = {DEFAULT_NOTHING_ATTACHED, DEFAULT_NOTHING_ATTACHED, DEFAULT_NOTHING_ATTACHED, DEFAULT_NOTHING_ATTACHED};
+
+	if (scanForDisplays(addresses, 4, wirePort) == 0)
+	{
+		setError(ALPHA_ERROR_NACK_ADDRESS);
+		return false;
+	}
+
+	return (begin(addresses[0], addresses[1], addresses[2], addresses[3], wirePort));
+}
+
+//Check one display every intervalMillis from checkHotPlug()
+void HT16K33::enableHotPlug(uint16_t intervalMillis)
+{
+	hotPlugInterval = intervalMillis;
+	lastHotPlugCheck = millis();
+	nextHotPlugDisplay = 0;
+}
+
+void HT16K33::disableHotPlug()
+{
+	hotPlugInterval = 0;
+}
+
+//Call often from loop(). When the interval has passed one display is probed, in turn.
+//A display that answers after being faulted, or whose RAM no longer matches what was
+//sent because it was swapped or lost power, is restored from the cached state. Only
+//that display is sent to. A board swapped in while the digits were blank has matching
+//RAM, so a blank display has its recorded setup sent again on each check. Displays
+//showing anything are left alone while their RAM matches.
+//Returns a bitmask of the displays restored.
+uint8_t HT16K33::checkHotPlug()
+{
+	if (hotPlugInterval == 0 || millis() - lastHotPlugCheck < hotPlugInterval)
+		return 0;
+	lastHotPlugCheck = millis();
+
+	if (standby == true)
+		return 0; //Waking up restores every display
+
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+		return 0; //Only the transmit core may use the bus
+#endif
+
+	CallBudget budget(this);
+	uint8_t displayNumber = nextHotPlugDisplay;
+	nextHotPlugDisplay = (nextHotPlugDisplay + 1) % numberOfDisplays;
+
+	uint8_t address = lookUpDisplayAddress(displayNumber);
+	bool lostState = (bus.faultedDisplays >> displayNumber) & 0b1;
+
+	if (lostState == false)
+	{
+		//The read also shows the display is there. Bytes changed since the last flush
+		//are expected to differ.
+		uint8_t ram[16];
+		if (readRAMOnce(address, 0x00, ram, 16) == false)
+			return 0;
+
+		for (uint8_t x = 0; x < 16; x++)
+		{
+			if (((dirtyRAM[displayNumber] >> x) & 0b1) == 0 && ram[x] != displayRAM[displayNumber * 16 + x])
+				lostState = true;
+		}
+
+		if (lostState == false)
+		{
+			bool blank = true;
+			for (uint8_t x = 0; x < 16; x++)
+			{
+				if (displayRAM[displayNumber * 16 + x] != 0)
+					blank = false;
+			}
+			if (blank == false)
+				return 0; //The chip kept what was sent, so it kept its setup too
+
+			//The setup registers can't be read back, a new chip starts with its oscillator and
+			//display off and full dimming. Sending the recorded values again changes nothing
+			//on the chip that was already there.
+			uint8_t setup[3] = {(uint8_t)(ALPHA_CMD_SYSTEM_SETUP | (((clockStopped >> displayNumber) & 0b1) ^ 0b1)),
+								(uint8_t)(ALPHA_CMD_DIMMING_SETUP | bus.appliedBrightness[displayNumber]),
+								(uint8_t)(ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff)};
+			for (uint8_t x = 0; x < 3; x++)
+			{
+				if (writeRAM(address, setup[x]) == false)
+					break; //Faulted now, restored in full once it answers again
+			}
+			return 0;
+		}
+	}
+	else
+	{
+		uint8_t result = probeAddress(address);
+		recordResult(displayNumber, i2cResultToStatus(result));
+		if (result != 0)
+			return 0; //Still missing
+	}
+
+	if (lostState == false)
+		return 0;
+
+	bool clockWasStopped = (clockStopped >> displayNumber) & 0b1;
+
+	bus.displayError[displayNumber] = ALPHA_SUCCESS;
+	if (restoreDisplays(1 << displayNumber) == false)
+		return 0; //Tried again on its next check, the failed write marked it faulted
+
+	//Turned off with disableSystemClock() before it was lost, put it back that way
+	if (clockWasStopped == true && disableSystemClockSingle(displayNumber) == false)
+		return 0;
+
+	return (1 << displayNumber);
+}
+
+//Keep the fault state of a display up to date after a transaction
+void HT16K33::recordResult(uint8_t displayNumber, alpha_status_t status)
+{
+	if (status != ALPHA_SUCCESS)
+		setError(status);
+
+	if (displayNumber > 3)
+		return;
+
+	alpha_bus_state_t *state = busState();
+	if (status == ALPHA_SUCCESS)
+	{
+		state->faultedDisplays &= ~(1 << displayNumber);
+	}
+	else
+	{
+		state->faultedDisplays |= 1 << displayNumber;
+		state->displayError[displayNumber] = status;
+	}
+}
+
+//True if transactions to this address should be skipped
+bool HT16K33::isIsolated(uint8_t address)
+{
+	uint8_t faulted = busState()->faultedDisplays;
+	if (faultIsolation == false || faulted == 0)
+		return false;
+
+	uint8_t displayNumber = lookUpDisplayNumber(address);
+	if (displayNumber == ALPHA_NO_DISPLAY)
+		return false;
+
+	return ((faulted >> displayNumber) & 0b1);
+}
+
+/*-------------------------- Display configuration functions ---------------------------*/
+
+bool HT16K33::clear()
+{
+	//Clear the displayRAM array
+	for (uint8_t i = 0; i < 16 * numberOfDisplays; i++)
+		displayRAM[i] = 0;
+
+	for (uint8_t digit = 0; digit < 4 * numberOfDisplays; digit++)
+	{
+		displayDigits[digit].segments = 0;
+		displayDigits[digit].character = ' ';
+	}
+
+	digitPosition = 0;
+	streamDigit = 0; //A leading '.' or ':' goes on the first digit, as with print()
+
+	return (updateDisplay());
+}
+
+//Duty valid between 1 and 16
+bool HT16K33::setBrightness(uint8_t duty)
+{
+	CallBudget budget(this);
+	bool status = true;
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (setBrightnessSingle(i, duty) == false)
+			status = false;
+	}
+	return status;
+}
+
+bool HT16K33::setBrightnessSingle(uint8_t displayNumber, uint8_t duty)
+{
+	if (duty > 15)
+		duty = 15; //Error check
+
+	noteActivity();
+
+	if (displayNumber >= 4)
+	{
+		uint8_t dataToWrite = ALPHA_CMD_DIMMING_SETUP | duty;
+		return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
+	}
+
+	brightness[displayNumber] = duty;
+	return (writeDimming(displayNumber, limitBrightness(displayNumber)));
+}
+
+//Parameter "rate" in Hz
+//Valid options for "rate" are defined by datasheet: 2, 1, or 0.5 Hz
+//Any other input to this function will result in steady alphanumeric display
+bool HT16K33::setBlinkRate(float rate)
+{
+	CallBudget budget(this);
+	bool status = true;
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (setBlinkRateSingle(i, rate) == false)
+			status = false;
+	}
+	return status;
+}
+
+bool HT16K33::setBlinkRateSingle(uint8_t displayNumber, float rate)
+{
+	if (rate == 2)
+	{
+		blinkRate = ALPHA_BLINK_RATE_2HZ;
+	}
+	else if (rate == 1)
+	{
+		blinkRate = ALPHA_BLINK_RATE_1HZ;
+	}
+	else if (rate == 0.5)
+	{
+		blinkRate = ALPHA_BLINK_RATE_0_5HZ;
+	}
+	//default to no blink
+	else
+	{
+		blinkRate = ALPHA_BLINK_RATE_NOBLINK;
+	}
+
+	noteActivity();
+
+	uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
+	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
+}
+
+bool HT16K33::displayOnSingle(uint8_t displayNumber)
+{
+	return setDisplayOnOff(displayNumber, true);
+}
+bool HT16K33::displayOffSingle(uint8_t displayNumber)
+{
+	return setDisplayOnOff(displayNumber, false);
+}
+
+//Set or clear the display on/off bit of a given display number
+bool HT16K33::setDisplayOnOff(uint8_t displayNumber, bool turnOnDisplay)
+{
+	if (turnOnDisplay == true)
+		displayOnOff = ALPHA_DISPLAY_ON;
+	else
+		displayOnOff = ALPHA_DISPLAY_OFF;
+
+	noteActivity();
+
+	if (displayOnOff == ALPHA_DISPLAY_ON)
+		waitForClockSettle();
+
+	uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
+	return (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite));
+}
+
+//Turn on/off the entire display
+bool HT16K33::displayOn()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	displayOnOff = ALPHA_DISPLAY_ON;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (displayOnSingle(i) == false)
+			status = false;
+	}
+
+	return status;
+}
+
+bool HT16K33::displayOff()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	displayOnOff = ALPHA_DISPLAY_OFF;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (displayOffSingle(i) == false)
+			status = false;
+	}
+
+	return status;
+}
+
+bool HT16K33::decimalOnSingle(uint8_t displayNumber)
+{
+	return setDecimalOnOff(displayNumber, true);
+}
+
+bool HT16K33::decimalOffSingle(uint8_t displayNumber)
+{
+	return setDecimalOnOff(displayNumber, false);
+}
+
+bool HT16K33::setDecimalOnOff(uint8_t displayNumber, bool turnOnDecimal)
+{
+	if (displayNumber >= numberOfDisplays)
+		return false;
+
+	setDisplayAttribute(displayNumber, ALPHA_DIGIT_DECIMAL, turnOnDecimal);
+	return (updateDisplayDirty());
+}
+
+//Turn on/off the entire display
+bool HT16K33::decimalOn()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (decimalOnSingle(i) == false)
+			status = false;
+	}
+
+	//Serial.println(status);
+	return status;
+}
+
+bool HT16K33::decimalOff()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (decimalOffSingle(i) == false)
+			status = false;
+	}
+	return status;
+}
+
+bool HT16K33::colonOnSingle(uint8_t displayNumber)
+{
+	return setColonOnOff(displayNumber, true);
+}
+
+bool HT16K33::colonOffSingle(uint8_t displayNumber)
+{
+	return setColonOnOff(displayNumber, false);
+}
+
+bool HT16K33::setColonOnOff(uint8_t displayNumber, bool turnOnColon)
+{
+	if (displayNumber >= numberOfDisplays)
+		return false;
+
+	setDisplayAttribute(displayNumber, ALPHA_DIGIT_COLON, turnOnColon);
+	return (updateDisplayDirty());
+}
+
+bool HT16K33::colonOn()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (colonOnSingle(i) == false)
+			status = false;
+	}
+	return status;
+}
+
+bool HT16K33::colonOff()
+{
+	CallBudget budget(this);
+	bool status = true;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (colonOffSingle(i) == false)
+			status = false;
+	}
+	return status;
+}
+
+/*---------------------------- Light up functions ---------------------------------*/
+
+//Given a segment and a digit, set the matching bit within the RAM of the Holtek RAM set
+void HT16K33::illuminateSegment(uint8_t segment, uint8_t digit)
+{
+	uint8_t segmentNumber = segment - 'A'; //Convert the segment letter back to a number
+
+	if (segmentNumber > 13)
+		return; //Error check - not a segment
+
+	stampDigit(1 << segmentNumber, 1 << segmentNumber, digit);
+}
+
+//Given a binary set of segments and a digit, store this data into the RAM array
+void HT16K33::illuminateChar(uint16_t segmentsToTurnOn, uint8_t digit)
+{
+	//Only set bits, segments already on stay on
+	stampDigit(segmentsToTurnOn, segmentsToTurnOn, digit);
+}
+
+//Write the segments selected by segmentsToChange into the RAM of a digit in one pass.
+//Segments A-G sit on rows 0-3 of COM0-6, segments H-N on rows 4-7 of the COMs below:
+//  COM   0 1 2 3 4 5 6
+//  low   A B C D E F G
+//  high  I H J K L M N
+//Each COM is one even RAM byte holding the four digits of a display. Returns false if digit is out of range.
+bool HT16K33::stampDigit(uint16_t segmentsToTurnOn, uint16_t segmentsToChange, uint8_t digit)
+{
+	if (digit >= 4 * numberOfDisplays)
+		return false; //Error check - don't write past the end of displayRAM
+
+	segmentsToChange &= ALPHA_ALL_SEGMENTS;
+	alpha_digit_t *record = &displayDigits[digit];
+	record->segments = (record->segments & ~segmentsToChange) | (segmentsToTurnOn & segmentsToChange);
+	record->character = '\0';
+
+	writeDigitRAM(segmentsToTurnOn, segmentsToChange, digit);
+	return true;
+}
+
+//Draw segments into displayRAM only, the digit record is left as it is
+void HT16K33::writeDigitRAM(uint16_t segmentsToTurnOn, uint16_t segmentsToChange, uint8_t digit)
+{
+	//Reorder segments H-N into COM order
+	uint8_t highOn = ((segmentsToTurnOn >> 8) & 0x01) | ((segmentsToTurnOn >> 6) & 0x02) | ((segmentsToTurnOn >> 7) & 0x7C);
+	uint8_t highChange = ((segmentsToChange >> 8) & 0x01) | ((segmentsToChange >> 6) & 0x02) | ((segmentsToChange >> 7) & 0x7C);
+	uint8_t lowOn = segmentsToTurnOn & 0x7F;
+	uint8_t lowChange = segmentsToChange & 0x7F;
+
+	uint8_t displayNumber = digit / 4;
+	uint8_t row = digit % 4;
+	uint8_t *ram = displayRAM + displayNumber * 16;
+
+	for (uint8_t com = 0; com < 7; com++)
+	{
+		uint8_t changeBits = (((lowChange >> com) & 0b1) << row) | (((highChange >> com) & 0b1) << (row + 4));
+		if (changeBits == 0)
+			continue;
+
+		uint8_t onBits = (((lowOn >> com) & 0b1) << row) | (((highOn >> com) & 0b1) << (row + 4));
+		uint8_t dat = (ram[com * 2] & ~changeBits) | (onBits & changeBits);
+
+		if (dat != ram[com * 2])
+		{
+			ram[com * 2] = dat;
+			dirtyRAM[displayNumber] |= 1 << (com * 2);
+		}
+	}
+}
+
+//Show a character on display
+void HT16K33::printChar(uint8_t displayChar, uint8_t digit)
+{
+	//Take care of special characters, they are attributes of the digit
+	if ((displayChar == '.' || displayChar == ':') && digit < 4 * numberOfDisplays)
+	{
+		displayDigits[digit].segments |= (displayChar == '.') ? ALPHA_DIGIT_DECIMAL : ALPHA_DIGIT_COLON;
+		updateAttributes(digit / 4);
+	}
+
+	stampGlyph(lookUpGlyph(displayChar), digit, false);
+}
+
+//Cache entry of a character. Mixing in the high nibble gives ' ', '0' to '9', '-', '.'
+//and ':' their own entries when the cache has 16 or more. A smaller cache can't hold all
+//the digits, so some of them share an entry.
+static uint8_t glyphCacheIndex(uint8_t displayChar)
+{
+	return ((displayChar + (displayChar >> 4)) & (ALPHA_GLYPH_CACHE_SIZE - 1));
+}
+
+//Find a character in the glyph cache, filling the entry on a miss
+const alpha_glyph_t *HT16K33::lookUpGlyph(uint8_t displayChar)
+{
+	alpha_glyph_t *glyph = &glyphCache[glyphCacheIndex(displayChar)];
+
+	if (glyph->character == displayChar && (glyph->segments & ALPHA_GLYPH_VALID))
+	{
+		glyphCacheStats.hits++;
+		return glyph;
+	}
+
+	glyphCacheStats.misses++;
+
+	uint16_t segments = getSegmentsToTurnOn(getCharPosition(displayChar));
+	glyph->character = displayChar;
+	glyph->segments = segments | ALPHA_GLYPH_VALID;
+
+	//Segments A-G go on row 0 and H-N on row 4 of the COMs listed in stampDigit()
+	uint8_t high = ((segments >> 8) & 0x01) | ((segments >> 6) & 0x02) | ((segments >> 7) & 0x7C);
+	for (uint8_t com = 0; com < 7; com++)
+		glyph->stamp[com] = ((segments >> com) & 0b1) | (((high >> com) & 0b1) << 4);
+
+	return glyph;
+}
+
+//Write a cached character into a digit. With replace false, segments already on stay on.
+bool HT16K33::stampGlyph(const alpha_glyph_t *glyph, uint8_t digit, bool replace)
+{
+	if (digit >= 4 * numberOfDisplays)
+		return false;
+
+	uint8_t displayNumber = digit / 4;
+	uint8_t row = digit % 4;
+	uint8_t *ram = displayRAM + displayNumber * 16;
+	uint8_t keepMask = replace ? ~(0x11 << row) : 0xFF;
+
+	alpha_digit_t *record = &displayDigits[digit];
+	if (replace == true)
+		record->segments &= ~ALPHA_ALL_SEGMENTS;
+	record->segments |= glyph->segments & ALPHA_ALL_SEGMENTS;
+	if (glyph->character != '.' && glyph->character != ':')
+		record->character = glyph->character; //Those are attributes, the digit still shows its character
+
+	for (uint8_t com = 0; com < 7; com++)
+	{
+		uint8_t dat = (ram[com * 2] & keepMask) | (glyph->stamp[com] << row);
+		if (dat != ram[com * 2])
+		{
+			ram[com * 2] = dat;
+			dirtyRAM[displayNumber] |= 1 << (com * 2);
+		}
+	}
+
+	return true;
+}
+
+alpha_cache_stats_t HT16K33::getGlyphCacheStats()
+{
+	return glyphCacheStats;
+}
+
+void HT16K33::resetGlyphCacheStats()
+{
+	glyphCacheStats.hits = 0;
+	glyphCacheStats.misses = 0;
+}
+
+//Convert a character to its index in the segment table
+uint8_t HT16K33::getCharPosition(uint8_t displayChar)
+{
+	//moved alphanumeric_segs array to PROGMEM
+
+	//space
+	if (displayChar == ' ')
+		return 0;
+	//Printable Symbols
+	if (displayChar >= '!' && displayChar <= '~')
+		return (displayChar - '!' + 1);
+
+	return SFE_ALPHANUM_UNKNOWN_CHAR;
+}
+
+//Update the list to define a new segments display for a particular character
+bool HT16K33::defineChar(uint8_t displayChar, uint16_t segmentsToTurnOn)
+{
+	bool result = false;
+
+	//Check to see if character is within range of displayable ASCII characters
+	if (displayChar >= '!' && displayChar <= '~')
+	{
+	  //Get the index of character in table and update its 14-bit segment value
+	  uint16_t characterPosition = displayChar - '!' + 1;
+
+      //Drop the cached stamp so the new segments are used from now on
+      alpha_glyph_t * pGlyph = &glyphCache[glyphCacheIndex(displayChar)];
+      if (pGlyph -> character == displayChar)
+        pGlyph -> segments = 0;
+
+      //If the character was defined before, update that definition
+      struct CharDef * pOldCharDef = pCharDefList;
+      while (pOldCharDef && (pOldCharDef -> position != characterPosition))
+      {
+        pOldCharDef = pOldCharDef -> next;
+      }
+
+      if (pOldCharDef != NULL)
+      {
+        pOldCharDef -> segments = segmentsToTurnOn & 0x3FFF;
+        return true;
+      }
+
+      //Create a new character definition
+      struct CharDef * pNewCharDef = (CharDef *)calloc(1, sizeof(CharDef));
+      if (pNewCharDef == NULL)
+        return false; //Out of memory
+
+	  //Set the position to the table index
+      pNewCharDef -> position = characterPosition;
+      //Mask the segment value to 14 bits only
+      pNewCharDef -> segments = segmentsToTurnOn & 0x3FFF;
+      //New definition always goes at the end of the list
+      pNewCharDef -> next = NULL;
+
+      //If list is empty set it to the new item
+      if (pCharDefList == NULL)
+      {
+	    pCharDefList = pNewCharDef;
+      }
+      else
+      {
+      //Otherwise go to the end of the list and add it there
+      struct CharDef * pTail = pCharDefList;
+
+      while(pTail->next != NULL)
+      {
+        pTail = pTail->next;
+      }
+
+      pTail->next = pNewCharDef;
+    }
+	//We added the definition so we're all good
+	result = true;
+  }
+  return result;
+}
+
+//Get the character map from the definition list or default table
+uint16_t HT16K33::getSegmentsToTurnOn(uint8_t charPos)
+{
+  uint16_t segments = 0;
+  //pointer to a defined character in list
+  struct CharDef * pDefChar = pCharDefList;
+
+  //Search the chacters list for a match
+  while(pDefChar && (pDefChar->position != charPos))
+  {
+    pDefChar = pDefChar -> next;
+  }
+
+  //If we found a match return that value
+  if (pDefChar != NULL)
+  {
+    segments = pDefChar -> segments;
+  }
+  //Otherwise get the value from the table
+  else
+  {
+    segments = pgm_read_word_near(alphanumeric_segs + charPos);
+  }
+  return segments;
+}
+
+#if defined(ALPHA_PIPELINE)
+/*------------------------ Render/transmit pipeline ----------------------------*/
+
+//Split drawing and I2C between two cores. While the pipeline is on, updateDisplay() and
+//updateDisplayDirty() only hand the rendered frame to the transmit core, which sends it
+//with transmitFrame() while the next frame is drawn into the other buffer.
+//Only the transmit core may use the bus, so change setup registers from there. The idle
+//manager, hot-plug checks and restoreState() do nothing until endPipeline(). Errors,
+//faults and the applied dimming reach the render core one frame later.
+bool HT16K33::beginPipeline()
+{
+	if (standby == true && wake() == false)
+		return false;
+
+	transmitBus = bus;
+	transmitBus.lastError = ALPHA_SUCCESS;
+	for (uint8_t i = 0; i < 4; i++)
+		unsentDirty[i] = 0;
+
+	renderFrame = 0;
+	if (displayRAM != frameRAM[0])
+		memcpy(frameRAM[0], displayRAM, sizeof(frameRAM[0]));
+	displayRAM = frameRAM[0];
+	readyFrame = ALPHA_NO_FRAME;
+	ALPHA_MEMORY_BARRIER();
+	pipelineEnabled = true;
+
+	return true;
+}
+
+//Go back to sending from the calling core. Call once the transmit core has stopped.
+//Bytes not sent yet go out with the next update.
+void HT16K33::endPipeline()
+{
+	uint8_t frame = readyFrame;
+	for (uint8_t i = 0; i < 4; i++)
+	{
+		dirtyRAM[i] |= unsentDirty[i];
+		if (frame != ALPHA_NO_FRAME)
+			dirtyRAM[i] |= frameDirty[frame][i];
+	}
+
+	collectFrameResults();
+	pipelineEnabled = false;
+	readyFrame = ALPHA_NO_FRAME;
+}
+
+//Render core, while no frame is waiting: take over what the transmit core recorded. It
+//doesn't touch its copy again until the next frame is published.
+void HT16K33::collectFrameResults()
+{
+	alpha_status_t error = bus.lastError;
+	bus = transmitBus;
+	if (bus.lastError == ALPHA_SUCCESS)
+		bus.lastError = error; //Not read yet
+	transmitBus.lastError = ALPHA_SUCCESS;
+}
+
+//Render core: hand the current frame to the transmit core and keep drawing in the other
+//buffer. Returns false if the transmit core is still sending, the changes are then kept
+//and go out with the next submit. Doesn't wait, updateDisplay() and updateDisplayDirty() do.
+bool HT16K33::submitFrame()
+{
+	if (pipelineEnabled == false)
+		return (updateDisplayDirty());
+
+	bool idle = (readyFrame == ALPHA_NO_FRAME);
+	if (idle == true)
+	{
+		ALPHA_MEMORY_BARRIER();
+		collectFrameResults();
+	}
+
+	bool changed = false;
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (dirtyRAM[i] != 0)
+			changed = true;
+	}
+	if (changed == false)
+		return true; //Nothing waiting, don't hand over an empty frame
+
+	if (idle == false)
+	{
+		pipelineStats.framesDeferred++;
+		return false;
+	}
+
+	uint8_t frame = renderFrame;
+	for (uint8_t i = 0; i < 4; i++)
+	{
+		frameDirty[frame][i] = dirtyRAM[i];
+		dirtyRAM[i] = 0;
+	}
+
+	//Swap buffers, the new one starts as a copy so drawing can carry on from this frame
+	renderFrame ^= 1;
+	displayRAM = frameRAM[renderFrame];
+	memcpy(displayRAM, frameRAM[frame], sizeof(frameRAM[0]));
+
+	ALPHA_MEMORY_BARRIER();
+	readyFrame = frame; //Publish last, the transmit core only reads a frame after this
+	pipelineStats.framesSubmitted++;
+
+	return true;
+}
+
+//Transmit core: send the frame waiting from the render core, if any. Bytes that fail are
+//kept and sent again with the next frame.
+bool HT16K33::transmitFrame()
+{
+	uint8_t frame = readyFrame;
+	if (frame == ALPHA_NO_FRAME)
+		return true;
+	ALPHA_MEMORY_BARRIER();
+
+	CallBudget budget(this);
+
+	bool status = true;
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		uint16_t bytesToWrite = frameDirty[frame][i] | unsentDirty[i];
+		if (bytesToWrite == 0)
+			continue;
+
+		if (writeDisplayBytes(i, frameRAM[frame], bytesToWrite) == true)
+			unsentDirty[i] = 0;
+		else
+		{
+			unsentDirty[i] = bytesToWrite;
+			status = false;
+		}
+	}
+
+	pipelineStats.framesTransmitted++;
+	ALPHA_MEMORY_BARRIER();
+	readyFrame = ALPHA_NO_FRAME; //The render core may submit again
+
+	return status;
+}
+
+//Render core: submit, and if the transmit core is still busy wait for it so the last frame
+//isn't left behind when nothing more is drawn. Rendering only waits when it is ahead of
+//the bus. The wait is limited by the latency budget, past that the changes stay for the
+//next submit and false is returned.
+bool HT16K33::flushFrame()
+{
+	if (submitFrame() == true)
+		return true;
+
+	uint32_t startTime = micros();
+	while (readyFrame != ALPHA_NO_FRAME)
+	{
+		if (latencyBudget != 0 && micros() - startTime > latencyBudget)
+		{
+			bus.lastError = ALPHA_ERROR_TIMEOUT; //The render core's copy, setError() records for the transmit core
+			return false;
+		}
+		yield();
+	}
+	ALPHA_MEMORY_BARRIER();
+
+	return (submitFrame());
+}
+
+alpha_pipeline_stats_t HT16K33::getPipelineStats()
+{
+	return pipelineStats;
+}
+#endif
+
+/*----------------------------- Canvas functions ---------------------------------*/
+
+//Limit a canvas operation to the clip window. Returns false if nothing is left to draw.
+bool HT16K33::clipCanvas(uint8_t digit, uint16_t &segmentsToChange)
+{
+	if (digit < clipFirstDigit || digit > clipLastDigit || digit >= 4 * numberOfDisplays)
+		return false;
+
+	segmentsToChange &= clipSegments;
+	return (segmentsToChange != 0);
+}
+
+bool HT16K33::segmentOn(uint8_t segment, uint8_t digit)
+{
+	return setSegmentOnOff(segment, digit, true);
+}
+
+bool HT16K33::segmentOff(uint8_t segment, uint8_t digit)
+{
+	return setSegmentOnOff(segment, digit, false);
+}
+
+//Set or clear a single segment ('A' to 'N') of a digit
+bool HT16K33::setSegmentOnOff(uint8_t segment, uint8_t digit, bool turnOnSegment)
+{
+	uint8_t segmentNumber = segment - 'A';
+	if (segmentNumber > 13)
+		return false;
+
+	uint16_t segmentsToChange = 1 << segmentNumber;
+	if (clipCanvas(digit, segmentsToChange) == false)
+		return false;
+
+	return (stampDigit(turnOnSegment ? segmentsToChange : 0, segmentsToChange, digit));
+}
+
+bool HT16K33::toggleSegment(uint8_t segment, uint8_t digit)
+{
+	uint8_t segmentNumber = segment - 'A';
+	if (segmentNumber > 13)
+		return false;
+
+	uint16_t segmentsToChange = 1 << segmentNumber;
+	if (clipCanvas(digit, segmentsToChange) == false)
+		return false;
+
+	return (stampDigit(~getDigitSegments(digit), segmentsToChange, digit));
+}
+
+//Replace all segments of a digit
+bool HT16K33::setDigitSegments(uint16_t segmentsToTurnOn, uint8_t digit)
+{
+	uint16_t segmentsToChange = ALPHA_ALL_SEGMENTS;
+	if (clipCanvas(digit, segmentsToChange) == false)
+		return false;
+
+	return (stampDigit(segmentsToTurnOn, segmentsToChange, digit));
+}
+
+bool HT16K33::clearDigit(uint8_t digit)
+{
+	return (setDigitSegments(0, digit));
+}
+
+//14-bit segment map of a digit
+uint16_t HT16K33::getDigitSegments(uint8_t digit)
+{
+	if (digit >= 4 * numberOfDisplays)
+		return 0;
+
+	return (displayDigits[digit].segments & ALPHA_ALL_SEGMENTS);
+}
+
+//Read back the 14-bit segment map of a digit from displayRAM
+uint16_t HT16K33::readDigitRAM(uint8_t digit)
+{
+	uint8_t *ram = displayRAM + (digit / 4) * 16;
+	uint8_t row = digit % 4;
+	uint8_t low = 0;
+	uint8_t high = 0;
+
+	for (uint8_t com = 0; com < 7; com++)
+	{
+		low |= ((ram[com * 2] >> row) & 0b1) << com;
+		high |= ((ram[com * 2] >> (row + 4)) & 0b1) << com;
+	}
+
+	//Undo the COM ordering of segments H-N
+	return (low | ((uint16_t)(high & 0x01) << 8) | ((uint16_t)(high & 0x02) << 6) | ((uint16_t)(high & 0x7C) << 7));
+}
+
+//Turn on the given segments across a run of digits. Returns the number of digits drawn after clipping.
+uint8_t HT16K33::drawBar(uint8_t startDigit, uint8_t length, uint16_t segmentsToTurnOn)
+{
+	uint8_t digitsDrawn = 0;
+
+	for (uint8_t i = 0; i < length; i++)
+	{
+		uint16_t segmentsToChange = segmentsToTurnOn;
+		if (startDigit + i > 0xFF)
+			break;
+		if (clipCanvas(startDigit + i, segmentsToChange) == false)
+			continue;
+
+		stampDigit(segmentsToChange, segmentsToChange, startDigit + i);
+		digitsDrawn++;
+	}
+
+	return digitsDrawn;
+}
+
+//Draw a horizontal level meter with two steps per digit. A level of 0 is empty and
+//2 * numDigits is full. Only lowerSegments and upperSegments are touched.
+bool HT16K33::drawLevelMeter(uint8_t startDigit, uint8_t numDigits, uint8_t level, uint16_t lowerSegments, uint16_t upperSegments)
+{
+	bool status = false;
+
+	for (uint8_t i = 0; i < numDigits; i++)
+	{
+		uint16_t segmentsToChange = lowerSegments | upperSegments;
+		if (startDigit + i > 0xFF)
+			break;
+		if (clipCanvas(startDigit + i, segmentsToChange) == false)
+			continue;
+
+		uint16_t segmentsToTurnOn = 0;
+		if (level > 2 * i)
+			segmentsToTurnOn |= lowerSegments;
+		if (level > 2 * i + 1)
+			segmentsToTurnOn |= upperSegments;
+
+		stampDigit(segmentsToTurnOn, segmentsToChange, startDigit + i);
+		status = true;
+	}
+
 	return status;
 }
 
-/*---------------------------- Light up functions ---------------------------------*/
+//Restrict canvas drawing to a range of digits and a set of segments
+void HT16K33::setClipWindow(uint8_t firstDigit, uint8_t lastDigit, uint16_t segmentMask)
+{
+	clipFirstDigit = firstDigit;
+	clipLastDigit = lastDigit;
+	clipSegments = segmentMask & ALPHA_ALL_SEGMENTS;
+}
+
+void HT16K33::resetClipWindow()
+{
+	setClipWindow(0, 4 * 4 - 1);
+}
+
+#if defined(ALPHA_KEY_SCAN)
+/*-------------------------------- Key scan -----------------------------------*/
+
+//Start reporting key presses from the key matrix of a display. If interruptPin is given, the
+//ROW15/INT pin is set up as an active low interrupt and key data is only read while it is low.
+//Otherwise the INT flag register is polled, which is one byte instead of six.
+//The INT pins of several displays can be wired together to one pin, but all key scan
+//displays must use the same pin or none, a different choice returns false.
+bool HT16K33::enableKeyScan(uint8_t displayNumber, uint8_t interruptPin)
+{
+	if (displayNumber >= numberOfDisplays)
+		return false;
+
+	if ((keyScanDisplays & ~(1 << displayNumber)) != 0 && interruptPin != keyInterruptPin)
+		return false;
+
+	for (uint8_t x = 0; x < 3; x++)
+	{
+		keyState[displayNumber][x] = 0;
+		keyCandidate[displayNumber][x] = 0;
+	}
+	keyStableCount[displayNumber] = keyDebounceCount;
+	keyPending &= ~(1 << displayNumber);
+
+	keyInterruptPin = interruptPin;
+
+	uint8_t dataToWrite = ALPHA_CMD_ROW_INT_SETUP; //ROW15 stays a row driver
+	if (interruptPin != ALPHA_NO_PIN)
+	{
+		pinMode(keyInterruptPin, INPUT_PULLUP);
+		dataToWrite |= 0b01; //ROW15 becomes INT, active low
+	}
+
+	if (writeRAM(lookUpDisplayAddress(displayNumber), dataToWrite) == false)
+		return false;
+
+	keyScanDisplays |= 1 << displayNumber;
+	return true;
+}
+
+bool HT16K33::disableKeyScan(uint8_t displayNumber)
+{
+	if (displayNumber >= numberOfDisplays)
+		return false;
+
+	keyScanDisplays &= ~(1 << displayNumber);
+	keyPending &= ~(1 << displayNumber);
+
+	return (writeRAM(lookUpDisplayAddress(displayNumber), ALPHA_CMD_ROW_INT_SETUP));
+}
+
+//Minimum time between key scan reads. Only one display is read per interval.
+void HT16K33::setKeyScanInterval(uint16_t intervalMillis)
+{
+	keyScanInterval = intervalMillis;
+}
+
+//Number of identical reads needed before a key change is reported
+void HT16K33::setKeyDebounce(uint8_t matchingReads)
+{
+	if (matchingReads == 0)
+		matchingReads = 1; //Error check
+
+	keyDebounceCount = matchingReads;
+}
+
+//Safe to call from an interrupt on the INT pin. The next scanKeys() reads without waiting for the interval.
+void HT16K33::keyInterrupt()
+{
+	keyInterruptFlag = true;
+}
+
+//Call regularly from loop(). Reads at most one display per call so key scanning
+//never holds the bus for long, and skips the read entirely when no key is down.
+bool HT16K33::scanKeys()
+{
+	if (keyScanDisplays == 0)
+		return true;
+
+	if (keyInterruptFlag == false && (millis() - lastKeyScan < keyScanInterval))
+		return true;
+	lastKeyScan = millis();
+	keyInterruptFlag = false;
+
+	CallBudget budget(this);
+
+	//Round robin over the displays with key scan enabled
+	for (uint8_t x = 0; x < 4; x++)
+	{
+		uint8_t displayNumber = nextKeyDisplay;
+		nextKeyDisplay = (nextKeyDisplay + 1) % 4;
+
+		if ((keyScanDisplays >> displayNumber) & 0b1)
+			return (scanKeysSingle(displayNumber));
+	}
+
+	return true;
+}
+
+bool HT16K33::scanKeysSingle(uint8_t displayNumber)
+{
+	uint8_t address = lookUpDisplayAddress(displayNumber);
+
+	//Releases and debouncing need reads even after the INT flag clears
+	if (((keyPending >> displayNumber) & 0b1) == 0)
+	{
+		if (keyInterruptPin != ALPHA_NO_PIN)
+		{
+			if (digitalRead(keyInterruptPin) == HIGH)
+				return true;
+		}
+		else
+		{
+			uint8_t intFlag = 0;
+			if (readRAMOnce(address, ALPHA_REG_INT_FLAG, &intFlag, 1) == false)
+				return false;
+			if (intFlag == 0)
+				return true;
+		}
+	}
+
+	uint8_t keyData[6];
+	if (readRAMOnce(address, ALPHA_REG_KEY_DATA, keyData, 6) == false)
+		return false;
+
+	bool changed = false;
+	for (uint8_t x = 0; x < 3; x++)
+	{
+		uint16_t keys = (keyData[x * 2] | (keyData[x * 2 + 1] << 8)) & 0x1FFF;
+		if (keys != keyCandidate[displayNumber][x])
+			changed = true;
+		keyCandidate[displayNumber][x] = keys;
+	}
+
+	if (changed == true)
+		keyStableCount[displayNumber] = 1;
+	else if (keyStableCount[displayNumber] < keyDebounceCount)
+		keyStableCount[displayNumber]++;
+
+	bool keysDown = false;
+	bool stable = (keyStableCount[displayNumber] >= keyDebounceCount);
+
+	for (uint8_t x = 0; x < 3; x++)
+	{
+		if (stable == true)
+		{
+			uint16_t difference = keyState[displayNumber][x] ^ keyCandidate[displayNumber][x];
+			for (uint8_t k = 0; k < 13; k++)
+			{
+				if ((difference >> k) & 0b1)
+					queueKeyEvent(displayNumber, x * 13 + k, (keyCandidate[displayNumber][x] >> k) & 0b1);
+			}
+			keyState[displayNumber][x] = keyCandidate[displayNumber][x];
+		}
+
+		if (keyState[displayNumber][x] != 0 || keyCandidate[displayNumber][x] != 0)
+			keysDown = true;
+	}
+
+	if (keysDown == true || stable == false)
+		keyPending |= 1 << displayNumber;
+	else
+		keyPending &= ~(1 << displayNumber);
+
+	return true;
+}
+
+void HT16K33::queueKeyEvent(uint8_t displayNumber, uint8_t key, bool pressed)
+{
+	uint8_t nextHead = (keyEventHead + 1) & (ALPHA_KEY_EVENT_QUEUE_SIZE - 1);
+	if (nextHead == keyEventTail)
+	{
+		keyEventsDropped++; //Queue full, drop the newest event
+		return;
+	}
+
+	keyEvents[keyEventHead].displayNumber = displayNumber;
+	keyEvents[keyEventHead].key = key;
+	keyEvents[keyEventHead].pressed = pressed;
+	keyEventHead = nextHead;
+}
+
+uint8_t HT16K33::keyEventsAvailable()
+{
+	return ((keyEventHead - keyEventTail) & (ALPHA_KEY_EVENT_QUEUE_SIZE - 1));
+}
+
+//Take the oldest key event from the queue. Returns false if there is none.
+bool HT16K33::readKeyEvent(alpha_key_event_t *event)
+{
+	if (keyEventHead == keyEventTail)
+		return false;
+
+	*event = keyEvents[keyEventTail];
+	keyEventTail = (keyEventTail + 1) & (ALPHA_KEY_EVENT_QUEUE_SIZE - 1);
+	return true;
+}
+
+//Debounced state of a key
+bool HT16K33::isKeyPressed(uint8_t displayNumber, uint8_t key)
+{
+	if (displayNumber > 3 || key > 38 || ((keyScanDisplays >> displayNumber) & 0b1) == 0)
+		return false;
+
+	return ((keyState[displayNumber][key / 13] >> (key % 13)) & 0b1);
+}
+
+uint16_t HT16K33::getKeyEventsDropped()
+{
+	return keyEventsDropped;
+}
+#endif
+
+#if defined(ALPHA_ZONES)
+/*---------------------------------- Zones -------------------------------------*/
+
+//Set up a range of digits refreshed at most every intervalMillis, a whole display is
+//four digits from 4 * displayNumber. Zones shouldn't overlap.
+bool HT16K33::defineZone(uint8_t zone, uint8_t firstDigit, uint8_t length, uint16_t intervalMillis)
+{
+	if (zone >= ALPHA_MAX_ZONES || length == 0 || firstDigit + length > 4 * numberOfDisplays)
+		return false;
+
+	alpha_zone_t *z = &zones[zone];
+	z->firstDigit = firstDigit;
+	z->length = length;
+	z->interval = intervalMillis;
+	z->nextDue = millis();
+	z->pending = false;
+	z->deadlineMisses = 0;
+
+	//Start from what is shown now
+	for (uint8_t x = 0; x < length; x++)
+		zoneDigits[firstDigit + x] = displayDigits[firstDigit + x];
+
+	return true;
+}
+
+//A zone that has been idle for a whole interval is due straight away
+void HT16K33::markZonePending(alpha_zone_t *zone)
+{
+	if (zone->pending == false && (int32_t)(millis() - zone->nextDue) > 0)
+		zone->nextDue = millis();
+
+	zone->pending = true;
+}
+
+//Lay out text in a zone, left aligned and cut to the zone. '.' and ':' go with the
+//digit before them. Nothing is sent until updateZones() finds the zone due.
+bool HT16K33::setZoneText(uint8_t zone, const char *text)
+{
+	if (zone >= ALPHA_MAX_ZONES || zones[zone].length == 0)
+		return false;
+
+	alpha_zone_t *z = &zones[zone];
+	alpha_digit_t *content = zoneDigits + z->firstDigit;
+
+	for (uint8_t x = 0; x < z->length; x++)
+	{
+		content[x].segments = 0;
+		content[x].character = ' ';
+	}
+
+	//Digits are counted from the start of the zone, a leading '.' or ':' goes on its first digit
+	alpha_stream_t stream = {0, z->length, 0, 0};
+	for (; *text != '\0'; text++)
+		parseChar(*text, content, &stream);
+
+	markZonePending(z);
+	return true;
+}
+
+//Replace one character of a zone, the decimal and colon of that digit are kept
+bool HT16K33::setZoneChar(uint8_t zone, uint8_t position, uint8_t displayChar)
+{
+	if (zone >= ALPHA_MAX_ZONES || position >= zones[zone].length)
+		return false;
+
+	alpha_zone_t *z = &zones[zone];
+	alpha_digit_t *record = &zoneDigits[z->firstDigit + position];
+	record->segments = (record->segments & ~ALPHA_ALL_SEGMENTS) | (lookUpGlyph(displayChar)->segments & ALPHA_ALL_SEGMENTS);
+	record->character = displayChar;
+
+	markZonePending(z);
+	return true;
+}
+
+//Call often from loop(). Zones with new content that are due are drawn together and go
+//out in one dirty flush, so each chip gets at most one transaction per run of changed
+//bytes no matter how many zones were due.
+bool HT16K33::updateZones()
+{
+	uint32_t now = millis();
+	uint8_t changedDisplays = 0;
+
+	for (uint8_t zone = 0; zone < ALPHA_MAX_ZONES; zone++)
+	{
+		alpha_zone_t *z = &zones[zone];
+		if (z->length == 0 || z->pending == false)
+			continue;
+
+		if (z->interval != 0)
+		{
+			uint32_t late = now - z->nextDue;
+			if ((int32_t)late < 0)
+				continue; //Not due yet
+
+			if (late >= z->interval)
+			{
+				//A whole refresh was lost, start the schedule again from now
+				z->deadlineMisses++;
+				z->nextDue = now + z->interval;
+			}
+			else
+				z->nextDue += z->interval;
+		}
+
+		for (uint8_t digit = z->firstDigit; digit < z->firstDigit + z->length; digit++)
+		{
+			uint16_t segments = zoneDigits[digit].segments & ALPHA_ALL_SEGMENTS;
+			if (segments != getDigitSegments(digit))
+				writeDigitRAM(segments, ALPHA_ALL_SEGMENTS, digit);
+
+			displayDigits[digit] = zoneDigits[digit];
+			changedDisplays |= 1 << (digit / 4);
+		}
+
+		z->pending = false;
+	}
+
+	if (changedDisplays == 0)
+		return true;
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if ((changedDisplays >> i) & 0b1)
+			updateAttributes(i);
+	}
+
+	return (updateDisplayDirty());
+}
+
+uint16_t HT16K33::getZoneDeadlineMisses(uint8_t zone)
+{
+	if (zone >= ALPHA_MAX_ZONES)
+		return 0;
+	return zones[zone].deadlineMisses;
+}
+#endif
+
+/*-------------------------------- Clock mode ----------------------------------*/
+
+//Use the four digits of a display as an HH:MM clock. Set leadingZero to false to blank
+//the first digit for hours below 10.
+bool HT16K33::beginClock(uint8_t displayNumber, bool leadingZero)
+{
+	if (displayNumber >= numberOfDisplays)
+		return false;
+
+	clockDisplay = displayNumber;
+	clockLeadingZero = leadingZero;
+
+	return true;
+}
+
+//Show a new time. Only digits that don't already show the right character are stamped and
+//only their RAM bytes are sent, so a new minute usually costs one short transaction.
+bool HT16K33::setClockTime(uint8_t hours, uint8_t minutes)
+{
+	if (clockDisplay == ALPHA_NO_DISPLAY)
+		return false;
+
+	hours %= 100;
+	minutes %= 100;
+
+	char newDigits[4];
+	newDigits[0] = '0' + hours / 10;
+	newDigits[1] = '0' + hours % 10;
+	newDigits[2] = '0' + minutes / 10;
+	newDigits[3] = '0' + minutes % 10;
+
+	if (clockLeadingZero == false && hours < 10)
+		newDigits[0] = ' ';
+
+	for (uint8_t x = 0; x < 4; x++)
+	{
+		uint8_t digit = clockDisplay * 4 + x;
+		if (newDigits[x] == displayDigits[digit].character)
+			continue;
+
+		stampGlyph(lookUpGlyph(newDigits[x]), digit, true);
+	}
+
+	return (updateDisplayDirty());
+}
+
+//Only the colon byte is sent
+bool HT16K33::setClockColon(bool turnOnColon)
+{
+	if (clockDisplay == ALPHA_NO_DISPLAY)
+		return false;
+
+	setDisplayAttribute(clockDisplay, ALPHA_DIGIT_COLON, turnOnColon);
+	return (updateDisplayDirty());
+}
+
+//Call once a second for a blinking colon
+bool HT16K33::toggleClockColon()
+{
+	if (clockDisplay == ALPHA_NO_DISPLAY)
+		return false;
+
+	return (setClockColon((displayRAM[clockDisplay * 16 + 0x01] & 0x01) == 0));
+}
+
+/*------------------------------- Text layout ---------------------------------*/
+
+//Choose how write() and print() place text on the digits
+void HT16K33::setTextLayout(alpha_align_t align, alpha_overflow_t overflow)
+{
+	textAlign = align;
+	textOverflow = overflow;
+}
+
+//Show the next part of text printed with ALPHA_OVERFLOW_SCROLL. Starts over after the end is shown.
+bool HT16K33::scrollText()
+{
+	if (scrollLength == 0)
+		return false;
+
+	uint8_t glyphs = 0;
+	for (uint8_t i = 0; i < scrollLength; i++)
+	{
+		if (scrollBuffer[i] != '.' && scrollBuffer[i] != ':')
+			glyphs++;
+	}
+
+	scrollPosition++;
+	if (scrollPosition + 4 * numberOfDisplays > glyphs)
+		scrollPosition = 0;
+
+	return (layoutText(scrollBuffer, scrollLength, scrollPosition));
+}
+
+//Lay out text starting at glyph firstGlyph using the alignment and overflow policy.
+//The resulting segment maps are compared with the digit records and only digits that
+//differ are stamped, then only the changed bytes are sent.
+//'.' and ':' don't take a digit, they are attributes of the digit before them.
+bool HT16K33::layoutText(const uint8_t *text, size_t size, uint8_t firstGlyph)
+{
+	uint8_t numDigits = 4 * numberOfDisplays;
+	alpha_digit_t content[4 * 4];
+
+	//Count the characters that need a digit
+	size_t glyphs = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		if (text[i] != '.' && text[i] != ':')
+			glyphs++;
+	}
+
+	size_t shown = (glyphs > firstGlyph) ? glyphs - firstGlyph : 0;
+	bool ellipsis = false;
+	if (shown > numDigits)
+	{
+		shown = numDigits;
+		if (textOverflow == ALPHA_OVERFLOW_ELLIPSIS)
+			ellipsis = true;
+	}
+
+	uint8_t offset = 0;
+	if (textAlign == ALPHA_ALIGN_RIGHT)
+		offset = numDigits - shown;
+	else if (textAlign == ALPHA_ALIGN_CENTER)
+		offset = (numDigits - shown) / 2;
+
+	for (uint8_t digit = 0; digit < numDigits; digit++)
+	{
+		content[digit].segments = 0;
+		content[digit].character = ' ';
+	}
+
+	//A leading '.' or ':' goes on the first digit, if there is one
+	uint8_t firstDigit = (offset < numDigits) ? offset : ALPHA_NO_DIGIT;
+	alpha_stream_t stream = {offset, (uint8_t)(offset + shown), firstDigit, firstGlyph};
+	for (size_t i = 0; i < size; i++)
+		parseChar(text[i], content, &stream);
+
+	if (ellipsis == true)
+	{
+		content[numDigits - 1].segments = (content[numDigits - 1].segments & ~ALPHA_ALL_SEGMENTS) | ALPHA_ELLIPSIS_SEGMENTS;
+		content[numDigits - 1].character = '\0';
+	}
+
+	//Only stamp the digits that changed
+	for (uint8_t digit = 0; digit < numDigits; digit++)
+	{
+		uint16_t segments = content[digit].segments & ALPHA_ALL_SEGMENTS;
+		if (segments != getDigitSegments(digit))
+			writeDigitRAM(segments, ALPHA_ALL_SEGMENTS, digit);
+
+		displayDigits[digit] = content[digit];
+	}
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+		updateAttributes(i);
+
+	//write() carries on from here, under the same overflow policy
+	digitPosition = stream.cursor;
+	streamDigit = stream.lastDigit;
+
+	return (updateDisplayDirty());
+}
+
+//One step of the character stream, shared by write() and layoutText(). A '.' or ':' is
+//an attribute of the digit of the character before it. Any other character replaces the
+//segments of the digit at the cursor and moves the cursor on, unless it is still being
+//skipped or the cursor has reached the end. The digit keeps its decimal and colon, so one
+//put there by a leading '.' or ':' stays. Returns the digit changed, ALPHA_NO_DIGIT if none.
+uint8_t HT16K33::parseChar(uint8_t displayChar, alpha_digit_t *content, alpha_stream_t *stream)
+{
+	if (displayChar == '.' || displayChar == ':')
+	{
+		uint8_t digit = stream->lastDigit;
+		if (digit == ALPHA_NO_DIGIT)
+			return ALPHA_NO_DIGIT; //The character before isn't shown
+
+		content[digit].segments |= (displayChar == '.') ? ALPHA_DIGIT_DECIMAL : ALPHA_DIGIT_COLON;
+		return digit;
+	}
+
+	if (stream->skip > 0 || stream->cursor >= stream->end)
+	{
+		if (stream->skip > 0)
+			stream->skip--;
+		stream->lastDigit = ALPHA_NO_DIGIT;
+		return ALPHA_NO_DIGIT;
+	}
+
+	uint8_t digit = stream->cursor++;
+	content[digit].segments = (content[digit].segments & ~ALPHA_ALL_SEGMENTS) | (lookUpGlyph(displayChar)->segments & ALPHA_ALL_SEGMENTS);
+	content[digit].character = displayChar;
+	stream->lastDigit = digit;
+	return digit;
+}
+
+//Show an image from flash, displays past the end of it are blanked. The RAM of each
+//display goes out in one write.
+bool HT16K33::displayImage(const uint8_t *ram, const char *text, const uint8_t *attributes, uint8_t length, uint8_t displays)
+{
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (i < displays)
+			memcpy_P(displayRAM + i * 16, ram + i * 16, 16);
+		else
+			memset(displayRAM + i * 16, 0, 16);
+
+		loadDigits(i, (i < displays) ? pgm_read_byte(attributes + i) : 0);
+
+		for (uint8_t x = 0; x < 4; x++)
+			displayDigits[i * 4 + x].character = (i < displays) ? pgm_read_byte(text + i * 4 + x) : ' ';
+	}
+
+	digitPosition = (length < 4 * numberOfDisplays) ? length : 4 * numberOfDisplays;
+	streamDigit = (digitPosition > 0) ? digitPosition - 1 : 0;
+
+	return (updateDisplay());
+}
+
+//Set or clear bit 0 of a RAM byte, used by the decimal and colon
+void HT16K33::setRAMBit(uint8_t displayNumber, uint8_t adr, bool turnOn)
+{
+	uint8_t *ram = displayRAM + displayNumber * 16 + adr;
+	uint8_t dat = turnOn ? (*ram | 0x01) : (*ram & ~0x01);
 
-//Given a segment and a digit, set the matching bit within the RAM of the Holtek RAM set
-void HT16K33::illuminateSegment(uint8_t segment, uint8_t digit)
+	if (dat != *ram)
+	{
+		*ram = dat;
+		dirtyRAM[displayNumber] |= 1 << adr;
+	}
+}
+
+//Turn an attribute on or off for a whole display. Turning it on gives it to the second
+//digit, which the colon and decimal sit after, unless a digit already has it.
+void HT16K33::setDisplayAttribute(uint8_t displayNumber, uint16_t attribute, bool turnOn)
 {
-	uint8_t com;
-	uint8_t row;
+	alpha_digit_t *records = displayDigits + displayNumber * 4;
+	bool alreadyOn = false;
 
-	com = segment - 'A'; //Convert the segment letter back to a number
+	for (uint8_t x = 0; x < 4; x++)
+	{
+		if (turnOn == false)
+			records[x].segments &= ~attribute;
+		else if (records[x].segments & attribute)
+			alreadyOn = true;
+	}
 
-	if (com > 6)
-		com -= 7;
-	if (segment == 'I')
-		com = 0;
-	if (segment == 'H')
-		com = 1;
+	if (turnOn == true && alreadyOn == false)
+		records[1].segments |= attribute;
 
-	row = digit % 4; //Convert digit (1 to 16) back to a relative position on a given display
-	if (segment > 'G')
-		row += 4;
+	updateAttributes(displayNumber);
+}
 
-	uint8_t offset = digit / 4 * 16;
-	uint8_t adr = com * 2 + offset;
+//Set the decimal and colon bits of a display from its digit records
+void HT16K33::updateAttributes(uint8_t displayNumber)
+{
+	uint16_t attributes = 0;
+	for (uint8_t x = 0; x < 4; x++)
+		attributes |= displayDigits[displayNumber * 4 + x].segments;
 
-	//Determine the address
-	if (row > 7)
-		adr++;
+	setRAMBit(displayNumber, 0x03, attributes & ALPHA_DIGIT_DECIMAL);
+	setRAMBit(displayNumber, 0x01, attributes & ALPHA_DIGIT_COLON);
+}
 
-	//Determine the data bit
-	if (row > 7)
-		row -= 8;
-	uint8_t dat = 1 << row;
+//Rebuild the digit records of a display after its RAM was written directly. The
+//characters aren't known. Attributes has the digits with the decimal in bits 0-3 and
+//the colon in bits 4-7, as in alpha_image_t.
+void HT16K33::loadDigits(uint8_t displayNumber, uint8_t attributes)
+{
+	for (uint8_t x = 0; x < 4; x++)
+	{
+		alpha_digit_t *record = &displayDigits[displayNumber * 4 + x];
+		record->segments = readDigitRAM(displayNumber * 4 + x);
+		record->character = '\0';
+
+		if (attributes & (0x01 << x))
+			record->segments |= ALPHA_DIGIT_DECIMAL;
+		if (attributes & (0x10 << x))
+			record->segments |= ALPHA_DIGIT_COLON;
+	}
+}
 
-	//Temp DEBUGGING - clear segments that might affect A0/A1
-	//dat &= 0b11111100;
+//Draw displayRAM again from the digit records, only bytes that change are marked dirty
+bool HT16K33::redrawDigits()
+{
+	for (uint8_t digit = 0; digit < 4 * numberOfDisplays; digit++)
+		writeDigitRAM(displayDigits[digit].segments, ALPHA_ALL_SEGMENTS, digit);
 
-	// Serial.print("illSeg Digit: ");
-	// Serial.print(digit);
-	// Serial.print("\t row: ");
-	// Serial.print(row);
-	// Serial.print("\t com: ");
-	// Serial.print(com);
-	// Serial.print("\t adr: ");
-	// Serial.print(adr);
-	// Serial.println();
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+		updateAttributes(i);
 
-	displayRAM[adr] = displayRAM[adr] | dat;
+	return (updateDisplayDirty());
 }
 
-//Given a binary set of segments and a digit, store this data into the RAM array
-void HT16K33::illuminateChar(uint16_t segmentsToTurnOn, uint8_t digit)
+/*------------------------------- Command queue ---------------------------------*/
+
+//Claim a slot of the command queue by moving head on from expected. Lock free where the
+//compiler has native byte atomics, otherwise the compare and swap is done under a lock:
+//a spin lock on the RP2040, held off interrupts on single core boards.
+static bool claimQueueSlot(volatile uint8_t *head, uint8_t expected)
 {
-	for (uint8_t i = 0; i < 14; i++) //There are 14 segments on this display
+#if defined(ALPHA_QUEUE_LOCK_FREE)
+	return (__atomic_compare_exchange_n(head, &expected, (uint8_t)(expected + 1), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+#elif defined(ARDUINO_ARCH_RP2040)
+	bool claimed = false;
+	critical_section_enter_blocking(&commandQueueLock);
+	if (*head == expected)
+	{
+		*head = expected + 1;
+		claimed = true;
+	}
+	critical_section_exit(&commandQueueLock);
+	return claimed;
+#elif defined(ARDUINO_ARCH_AVR)
+	bool claimed = false;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (*head == expected)
+		{
+			*head = expected + 1;
+			claimed = true;
+		}
+	}
+	return claimed;
+#else
+	bool claimed = false;
+	noInterrupts();
+	if (*head == expected)
 	{
-		if ((segmentsToTurnOn >> i) & 0b1)
-			illuminateSegment('A' + i, digit); //Convert the segment number to a letter
+		*head = expected + 1;
+		claimed = true;
 	}
+	interrupts();
+	return claimed;
+#endif
 }
 
-//Show a character on display
-void HT16K33::printChar(uint8_t displayChar, uint8_t digit)
+//Each slot holds its sequence number. A producer may fill a slot when the sequence matches
+//the head it claimed, the consumer may read it once the producer has moved it one further.
+void HT16K33::initCommandQueue()
 {
-	//moved alphanumeric_segs array to PROGMEM
-	uint16_t characterPosition = 65532;
+#if !defined(ALPHA_QUEUE_LOCK_FREE) && defined(ARDUINO_ARCH_RP2040)
+	if (critical_section_is_initialized(&commandQueueLock) == false)
+		critical_section_init(&commandQueueLock); //Shared by all instances, claims a spin lock once
+#endif
 
-	//space
-	if (displayChar == ' ')
-		characterPosition = 0;
-	//Printable Symbols
-	else if (displayChar >= '!' && displayChar <= '~')
+	for (uint8_t i = 0; i < ALPHA_COMMAND_QUEUE_SIZE; i++)
+		commandQueue[i].sequence = i;
+
+	commandHead = 0;
+	commandTail = 0;
+	ALPHA_MEMORY_BARRIER();
+	commandQueueReady = true;
+}
+
+//Add a command to the queue without touching the I2C bus. Safe to call from any task or
+//interrupt while another task calls processCommands(). Returns false if the queue is full.
+bool HT16K33::postCommand(alpha_queue_command_t command, uint8_t target, uint16_t value)
+{
+	if (commandQueueReady == false)
+		return false; //begin() has not been called
+
+	uint8_t position = commandHead;
+	alpha_queue_slot_t *slot;
+
+	while (true)
 	{
-		characterPosition = displayChar - '!' + 1;
-	}
+		slot = &commandQueue[position & (ALPHA_COMMAND_QUEUE_SIZE - 1)];
+		int8_t difference = (int8_t)(slot->sequence - position);
 
-	uint8_t dispNum = digitPosition / 4;
-	//Take care of special characters
-	if (characterPosition == 14) //'.'
-		decimalOnSingle(dispNum);
-	if (characterPosition == 26) //':'
-		colonOnSingle(dispNum);
-	if (characterPosition == 65532) //unknown character
-		characterPosition = SFE_ALPHANUM_UNKNOWN_CHAR;
+		if (difference == 0)
+		{
+			if (claimQueueSlot(&commandHead, position) == true)
+				break;
+		}
+		else if (difference < 0)
+		{
+			commandsDropped++; //Full, the consumer hasn't freed this slot yet
+			return false;
+		}
 
-	// //Error check
-	// if (characterPosition > sizeof(alphanumeric_segs))
-	// 	characterPosition = sizeof(alphanumeric_segs) - 1; //Unknown char
+		position = commandHead; //Another producer got there first
+	}
 
-	uint16_t segmentsToTurnOn = getSegmentsToTurnOn(characterPosition);
+	slot->command = command;
+	slot->target = target;
+	slot->value = value;
+	ALPHA_MEMORY_BARRIER();
+	slot->sequence = position + 1; //Hand the slot to the consumer
 
-	illuminateChar(segmentsToTurnOn, digit);
+	return true;
 }
 
-//Update the list to define a new segments display for a particular character
-bool HT16K33::defineChar(uint8_t displayChar, uint16_t segmentsToTurnOn)
+//Run all queued commands. Drawing commands are applied to displayRAM in order and sent
+//in one batch at the end. Setup commands are merged so only the last value for each
+//register is sent. Call this from the one task that owns the I2C bus.
+bool HT16K33::processCommands()
 {
-	bool result = false;
+	if (commandQueueReady == false)
+		return false;
 
-	//Check to see if character is within range of displayable ASCII characters
-	if (displayChar >= '!' && displayChar <= '~')
+	uint8_t newBrightness[4];
+	uint8_t brightnessChanged = 0;
+	uint8_t newBlinkRate = blinkRate;
+	uint8_t newDisplayOnOff = displayOnOff;
+	uint8_t processed = 0;
+	bool status = true;
+
+	while (true)
 	{
-	  //Get the index of character in table and update its 14-bit segment value
-	  uint16_t characterPosition = displayChar - '!' + 1;
+		alpha_queue_slot_t *slot = &commandQueue[commandTail & (ALPHA_COMMAND_QUEUE_SIZE - 1)];
+		if (slot->sequence != (uint8_t)(commandTail + 1))
+			break; //Empty, or the producer is still filling the slot
+		ALPHA_MEMORY_BARRIER();
 
-      //Create a new character definition
-      struct CharDef * pNewCharDef = (CharDef *)calloc(1, sizeof(CharDef));
+		uint8_t target = slot->target;
+		uint16_t value = slot->value;
 
-	  //Set the position to the table index
-      pNewCharDef -> position = characterPosition;
-      //Mask the segment value to 14 bits only
-      pNewCharDef -> segments = segmentsToTurnOn & 0x3FFF;
-      //New definition always goes at the end of the list
-      pNewCharDef -> next = NULL;
+		switch (slot->command)
+		{
+		case ALPHA_QUEUE_CHAR:
+			if (value == '.' || value == ':')
+				printChar(value, target); //An attribute, the digit keeps its character
+			else
+				stampGlyph(lookUpGlyph(value), target, true);
+			break;
+		case ALPHA_QUEUE_SEGMENTS:
+			stampDigit(value, ALPHA_ALL_SEGMENTS, target);
+			break;
+		case ALPHA_QUEUE_DECIMAL:
+			if (target < numberOfDisplays)
+				setDisplayAttribute(target, ALPHA_DIGIT_DECIMAL, value);
+			break;
+		case ALPHA_QUEUE_COLON:
+			if (target < numberOfDisplays)
+				setDisplayAttribute(target, ALPHA_DIGIT_COLON, value);
+			break;
+		case ALPHA_QUEUE_CLEAR:
+			for (uint8_t digit = 0; digit < 4 * numberOfDisplays; digit++)
+			{
+				displayDigits[digit].segments = 0;
+				displayDigits[digit].character = ' ';
+			}
+			for (uint8_t i = 0; i < numberOfDisplays; i++)
+			{
+				for (uint8_t x = 0; x < 16; x++)
+				{
+					if (displayRAM[i * 16 + x] != 0)
+					{
+						displayRAM[i * 16 + x] = 0;
+						dirtyRAM[i] |= 1 << x;
+					}
+				}
+			}
+			break;
+		case ALPHA_QUEUE_BRIGHTNESS:
+			if (target < numberOfDisplays)
+			{
+				newBrightness[target] = (value > 15) ? 15 : value;
+				brightnessChanged |= 1 << target;
+			}
+			break;
+		case ALPHA_QUEUE_BLINK_RATE:
+			newBlinkRate = value & 0b11;
+			break;
+		case ALPHA_QUEUE_DISPLAY_ON_OFF:
+			newDisplayOnOff = (value != 0) ? ALPHA_DISPLAY_ON : ALPHA_DISPLAY_OFF;
+			break;
+		}
 
-      //If list is empty set it to the new item
-      if (pCharDefList == NULL)
-      {
-	    pCharDefList = pNewCharDef;
-      }
-      else
-      {
-      //Otherwise go to the end of the list and add it there
-      struct CharDef * pTail = pCharDefList;
+		ALPHA_MEMORY_BARRIER();
+		slot->sequence = commandTail + ALPHA_COMMAND_QUEUE_SIZE; //Give the slot back to producers
+		commandTail++;
+		processed++;
+	}
 
-      while(pTail->next != NULL)
-      {
-        pTail = pTail->next;
-      }
+	if (processed == 0)
+		return true; //Nothing to do, don't wake the displays
 
-      pTail->next = pNewCharDef;
-    }
-	//We added the definition so we're all good
-	result = true;
-  }
-  return result;
-}
+	CallBudget budget(this);
 
-//Get the character map from the definition list or default table
-uint16_t HT16K33::getSegmentsToTurnOn(uint8_t charPos)
-{
-  uint16_t segments = 0;
-  //pointer to a defined character in list
-  struct CharDef * pDefChar = pCharDefList;
+	if (updateDisplayDirty() == false)
+		status = false;
 
-  //Search the chacters list for a match
-  while(pDefChar && (pDefChar->position != charPos))
-  {
-    pDefChar = pDefChar -> next;
-  }
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (((brightnessChanged >> i) & 0b1) && newBrightness[i] != brightness[i])
+		{
+			if (setBrightnessSingle(i, newBrightness[i]) == false)
+				status = false;
+		}
+	}
 
-  //If we found a match return that value
-  if (pDefChar != NULL)
-  {
-    segments = pDefChar -> segments;
-  }
-  //Otherwise get the value from the table
-  else
-  {
-    segments = pgm_read_word_near(alphanumeric_segs + charPos);
-  }
-  return segments;
+	if (newBlinkRate != blinkRate || newDisplayOnOff != displayOnOff)
+	{
+		blinkRate = newBlinkRate;
+		displayOnOff = newDisplayOnOff;
+		if (displayOnOff == ALPHA_DISPLAY_ON)
+			waitForClockSettle();
+
+		for (uint8_t i = 0; i < numberOfDisplays; i++)
+		{
+			uint8_t dataToWrite = ALPHA_CMD_DISPLAY_SETUP | (blinkRate << 1) | displayOnOff;
+			if (writeRAM(lookUpDisplayAddress(i), dataToWrite) == false)
+				status = false;
+		}
+	}
+
+	return status;
+}
+
+uint16_t HT16K33::getCommandsDropped()
+{
+	return commandsDropped;
 }
 
 /*
@@ -748,16 +2832,50 @@ uint16_t HT16K33::getSegmentsToTurnOn(uint8_t charPos)
  */
 size_t HT16K33::write(uint8_t b)
 {
-	//If user wants to print '.' or ':', don't increment the digitPosition!
-	if (b == '.' | b == ':')
-		printChar(b, 0);
-	else
+	uint8_t numDigits = 4 * numberOfDisplays;
+
+	//Once the digits are full the overflow policy of setTextLayout() applies, as it does
+	//to print(). ALPHA_OVERFLOW_SCROLL moves the digits left to make room.
+	bool attribute = (b == '.' || b == ':');
+	if (attribute == false && digitPosition >= numDigits)
+	{
+		if (textOverflow == ALPHA_OVERFLOW_SCROLL)
+		{
+			for (uint8_t x = 0; x + 1 < numDigits; x++)
+				displayDigits[x] = displayDigits[x + 1];
+			digitPosition = numDigits - 1;
+			alpha_stream_t stream = {digitPosition, numDigits, ALPHA_NO_DIGIT, 0};
+			parseChar(b, displayDigits, &stream);
+			digitPosition = stream.cursor;
+			streamDigit = stream.lastDigit;
+			return (redrawDigits());
+		}
+
+		streamDigit = ALPHA_NO_DIGIT; //The character isn't shown, so neither is a '.' after it
+		if (textOverflow == ALPHA_OVERFLOW_ELLIPSIS)
+		{
+			displayDigits[numDigits - 1].segments = (displayDigits[numDigits - 1].segments & ~ALPHA_ALL_SEGMENTS) | ALPHA_ELLIPSIS_SEGMENTS;
+			displayDigits[numDigits - 1].character = '\0';
+			writeDigitRAM(ALPHA_ELLIPSIS_SEGMENTS, ALPHA_ALL_SEGMENTS, numDigits - 1);
+		}
+		return (updateDisplayDirty());
+	}
+
+	//A '.' or ':' goes with the digit of the last character and doesn't move the cursor.
+	//Any other character replaces the segments only, a decimal or colon turned on with
+	//decimalOnSingle() or colonOnSingle() stays on as it always has.
+	alpha_stream_t stream = {digitPosition, numDigits, streamDigit, 0};
+	uint8_t digit = parseChar(b, displayDigits, &stream);
+	digitPosition = stream.cursor;
+	streamDigit = stream.lastDigit;
+
+	if (digit != ALPHA_NO_DIGIT)
 	{
-		printChar(b, digitPosition++);
-		digitPosition %= (numberOfDisplays * 4); //Convert displays to number of digits
+		writeDigitRAM(displayDigits[digit].segments, ALPHA_ALL_SEGMENTS, digit); //Only changed bytes are marked dirty
+		updateAttributes(digit / 4);
 	}
 
-	return (updateDisplay()); //Send RAM buffer over I2C bus
+	return (updateDisplayDirty()); //Send the changed bytes over I2C bus
 }
 
 /*
@@ -766,36 +2884,19 @@ size_t HT16K33::write(uint8_t b)
  */
 size_t HT16K33::write(const uint8_t *buffer, size_t size)
 {
-	size_t n = size;
-	uint8_t buff;
-
-	//Clear the displayRAM array
-	for (uint8_t i = 0; i < 16 * numberOfDisplays; i++)
-		displayRAM[i] = 0;
-
-	digitPosition = 0;
+	scrollLength = 0;
+	scrollPosition = 0;
 
-	while (size--)
+	//Keep the text around so scrollText() can show the rest of it
+	if (textOverflow == ALPHA_OVERFLOW_SCROLL)
 	{
-		buff = *buffer++;
-		//For special characters like '.' or ':', do not increment the digitPosition
-		if (buff == '.')
-			printChar('.', 0);
-		else if (buff == ':')
-			printChar(':', 0);
-		else
-		{
-			printChar(buff, digitPosition);
-			displayContent[digitPosition] = buff; //Record to internal array
-
-			digitPosition++;
-			digitPosition %= (numberOfDisplays * 4);
-		}
+		scrollLength = (size > ALPHA_SCROLL_BUFFER_SIZE) ? ALPHA_SCROLL_BUFFER_SIZE : size;
+		memcpy(scrollBuffer, buffer, scrollLength);
 	}
 
-	updateDisplay(); //Send RAM buffer over I2C bus
+	layoutText(buffer, size, 0);
 
-	return n;
+	return size;
 }
 
 //Write a string to the display
@@ -813,9 +2914,25 @@ bool HT16K33::updateDisplay()
 
 	bool status = true;
 
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+	{
+		for (uint8_t i = 0; i < numberOfDisplays; i++)
+			dirtyRAM[i] = 0xFFFF;
+		noteActivity();
+		return (flushFrame()); //Sent by the transmit core
+	}
+#endif
+
+	if (standby == true)
+		return (wake()); //Waking up sends all of displayRAM
+
+	CallBudget budget(this);
+	noteActivity();
+
 	for (uint8_t i = 0; i < numberOfDisplays; i++)
 	{
-		if (writeRAM(lookUpDisplayAddress(i), 0, (uint8_t *)(displayRAM + (i * 16)), 16) == false)
+		if (updateDisplayRAM(i, 0xFFFF) == false)
 		{
 			//Serial.print("updateDisplay fail at display 0x");
 			//Serial.println(lookUpDisplayAddress(i), HEX);
@@ -826,72 +2943,209 @@ bool HT16K33::updateDisplay()
 	return status;
 }
 
-//Shift the display content to the right one digit
-bool HT16K33::shiftRight(uint8_t shiftAmt)
+//Push only the displayRAM bytes that changed since the last flush
+bool HT16K33::updateDisplayDirty()
 {
-	for (uint8_t x = (4 * numberOfDisplays) - shiftAmt; x >= shiftAmt; x--)
+	bool status = true;
+
+#if defined(ALPHA_PIPELINE)
+	if (pipelineEnabled == true)
+	{
+		noteActivity();
+		return (flushFrame()); //Sent by the transmit core
+	}
+#endif
+
+	if (standby == true)
+		return (wake()); //Waking up sends all of displayRAM
+
+	CallBudget budget(this);
+	noteActivity();
+
+	for (uint8_t i = 0; i < numberOfDisplays; i++)
+	{
+		if (dirtyRAM[i] == 0)
+			continue; //Nothing to send to this display
+
+		if (updateDisplayRAM(i, dirtyRAM[i]) == false)
+			status = false;
+	}
+
+	return status;
+}
+
+//Send the selected bytes of a display's RAM using as few transactions as possible.
+//Runs of dirty bytes separated by a small gap are merged since re-sending a clean byte
+//is cheaper than the start, address and register bytes of another transaction.
+bool HT16K33::updateDisplayRAM(uint8_t displayNumber, uint16_t bytesToWrite)
+{
+	if (writeDisplayBytes(displayNumber, displayRAM, bytesToWrite) == false)
+		return false;
+
+	dirtyRAM[displayNumber] = 0;
+	return true;
+}
+
+//Send the selected bytes of one display from a RAM image of all displays
+//Sends the dimming first when the power budget lowers it or it is stale, and after the
+//RAM when it goes back up, so a heavy frame is never shown at the brighter setting.
+//The segments are only counted while the budget is on.
+bool HT16K33::writeDisplayBytes(uint8_t displayNumber, uint8_t *ram, uint16_t bytesToWrite)
+{
+	bool status = true;
+	uint8_t reg = 0;
+
+	ram += displayNumber * 16;
+
+	alpha_bus_state_t *state = busState();
+	if (powerBudget != 0)
+		state->litSegments[displayNumber] = countLitSegments(ram);
+
+	uint8_t duty = limitBrightness(displayNumber);
+	bool stale = (state->staleDimming >> displayNumber) & 0b1;
+	if ((duty < state->appliedBrightness[displayNumber] || stale == true) && writeDimming(displayNumber, duty) == false)
+		status = false;
+
+	while (reg < 16)
 	{
-		displayContent[x] = displayContent[x - shiftAmt];
+		if (((bytesToWrite >> reg) & 0b1) == 0)
+		{
+			reg++;
+			continue;
+		}
+
+		//Find the end of this run, bridging small gaps
+		uint8_t end = reg + 1;
+		uint8_t gap = 0;
+		for (uint8_t x = reg + 1; x < 16; x++)
+		{
+			if ((bytesToWrite >> x) & 0b1)
+			{
+				end = x + 1;
+				gap = 0;
+			}
+			else if (++gap > ALPHA_DIRTY_MERGE_GAP)
+				break;
+		}
+
+		if (writeRAM(lookUpDisplayAddress(displayNumber), reg, ram + reg, end - reg) == false)
+			status = false;
+
+		reg = end;
 	}
 
+	if (duty > state->appliedBrightness[displayNumber] && writeDimming(displayNumber, duty) == false)
+		status = false;
+
+	return status;
+}
+
+//Shift the display content to the right one digit. Segments, custom masks and the
+//decimal and colon all move with their digit.
+bool HT16K33::shiftRight(uint8_t shiftAmt)
+{
+	uint8_t numDigits = 4 * numberOfDisplays;
+	if (shiftAmt > numDigits)
+		shiftAmt = numDigits; //Error check
+
+	for (uint8_t x = numDigits; x > shiftAmt; x--)
+		displayDigits[x - 1] = displayDigits[x - 1 - shiftAmt];
+
 	//Clear the leading characters
 	for (uint8_t x = 0; x < shiftAmt; x++)
 	{
-		if (x + shiftAmt > (4 * numberOfDisplays))
-			break; //Error check
-
-		displayContent[0 + x] = ' ';
+		displayDigits[x].segments = 0;
+		displayDigits[x].character = ' ';
 	}
 
-	return (print(displayContent));
+	digitPosition = 0;
+	streamDigit = 0;
+	return (redrawDigits());
 }
 
 //Shift the display content to the left one digit
 bool HT16K33::shiftLeft(uint8_t shiftAmt)
 {
-	for (int x = 0; x < 4 * numberOfDisplays; x++)
-	{
-		if (x + shiftAmt > (4 * numberOfDisplays))
-			break; //Error check
-		displayContent[x] = displayContent[x + shiftAmt];
-	}
+	uint8_t numDigits = 4 * numberOfDisplays;
+	if (shiftAmt > numDigits)
+		shiftAmt = numDigits; //Error check
+
+	for (uint8_t x = 0; x + shiftAmt < numDigits; x++)
+		displayDigits[x] = displayDigits[x + shiftAmt];
 
 	//Clear the trailing characters
-	for (int x = 0; x < shiftAmt; x++)
+	for (uint8_t x = numDigits - shiftAmt; x < numDigits; x++)
 	{
-		if (4 * numberOfDisplays - 1 - x < 0)
-			break; //Error check
-
-		displayContent[4 * numberOfDisplays - 1 - x] = ' ';
+		displayDigits[x].segments = 0;
+		displayDigits[x].character = ' ';
 	}
 
-	return (print(displayContent));
+	digitPosition = 0;
+	streamDigit = 0;
+	return (redrawDigits());
 }
 
 /*----------------------- Internal I2C Abstraction -----------------------------*/
 
+//Read from the Holtek IC. The display is only probed with isConnected() if the first attempt
+//fails, so regular reads such as key scans don't pay for the retries.
 bool HT16K33::readRAM(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffSize)
 {
-	uint8_t displayNum = 0;
-	if (address == _deviceAddressLeftCenter)
-		displayNum = 1;
-	else if (address == _deviceAddressRightCenter)
-		displayNum = 2;
-	else if (address == _deviceAddressRight)
-		displayNum = 3;
-	isConnected(displayNum); //Wait until display is ready
+	CallBudget budget(this);
+
+	if (readRAMOnce(address, reg, buff, buffSize) == true)
+		return true;
+
+	uint8_t displayNumber = lookUpDisplayNumber(address);
+	if (displayNumber == ALPHA_NO_DISPLAY || isIsolated(address) == true)
+		return false;
+
+	//Wait until display is ready
+	if (probeDisplay(displayNumber) != ALPHA_SUCCESS)
+		return false;
+
+	return (readRAMOnce(address, reg, buff, buffSize));
+}
+
+bool HT16K33::readRAMOnce(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffSize)
+{
+	if (isIsolated(address) == true)
+		return false;
+
+	CallBudget budget(this);
+	if (startTransaction() == false)
+	{
+		setError(ALPHA_ERROR_TIMEOUT);
+		return false;
+	}
+
+	if (emulator != NULL)
+	{
+		uint8_t result = emulator->transmit(address, &reg, 1);
+		if (result == 0 && emulator->receive(address, buff, buffSize) < buffSize)
+			result = 2; //Same as a short read from the Wire port
+		recordResult(lookUpDisplayNumber(address), i2cResultToStatus(result));
+		return (result == 0);
+	}
 
 	_i2cPort->beginTransmission(address);
 	_i2cPort->write(reg);
-	_i2cPort->endTransmission(false);
+	uint8_t result = _i2cPort->endTransmission(false);
+	if (result != 0)
+	{
+		recordResult(lookUpDisplayNumber(address), i2cResultToStatus(result));
+		return false;
+	}
 
-	if (_i2cPort->requestFrom(address, buffSize) > 0)
+	if (_i2cPort->requestFrom(address, buffSize) >= buffSize)
 	{
 		for (uint8_t i = 0; i < buffSize; i++)
 			buff[i] = _i2cPort->read();
+		recordResult(lookUpDisplayNumber(address), ALPHA_SUCCESS);
 		return true;
 	}
 
+	recordResult(lookUpDisplayNumber(address), ALPHA_ERROR_NACK_ADDRESS);
 	return false;
 }
 
@@ -906,25 +3160,61 @@ bool HT16K33::readRAM(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffS
 //After much testing, it
 bool HT16K33::writeRAM(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffSize)
 {
-	uint8_t displayNum = 0;
-	if (address == _deviceAddressLeftCenter)
-		displayNum = 1;
-	else if (address == _deviceAddressRightCenter)
-		displayNum = 2;
-	else if (address == _deviceAddressRight)
-		displayNum = 3;
-	//isConnected(displayNum); //Wait until display is ready
+	if (isIsolated(address) == true)
+		return false; //Don't wait on a display known to be faulted
 
-	_i2cPort->beginTransmission(address);
-	_i2cPort->write(reg);
+	CallBudget budget(this);
+	if (startTransaction() == false)
+	{
+		setError(ALPHA_ERROR_TIMEOUT);
+		return false;
+	}
+
+	uint8_t result;
+	if (emulator != NULL)
+	{
+		//Command or address byte first, as it goes out on the bus
+		uint8_t transaction[1 + 16];
+		transaction[0] = reg;
+		if (buffSize > 16)
+			buffSize = 16;
+		memcpy(transaction + 1, buff, buffSize);
+		result = emulator->transmit(address, transaction, 1 + buffSize);
+	}
+	else
+	{
+		_i2cPort->beginTransmission(address);
+		_i2cPort->write(reg);
 
-	for (uint8_t i = 0; i < buffSize; i++)
-		_i2cPort->write(buff[i]);
+		for (uint8_t i = 0; i < buffSize; i++)
+			_i2cPort->write(buff[i]);
 
-	if (_i2cPort->endTransmission() == 0)
-		return true;
+		result = _i2cPort->endTransmission();
+	}
+	recordResult(lookUpDisplayNumber(address), i2cResultToStatus(result));
 
-	return false;
+	return (result == 0);
+}
+
+//Address only transaction, as used to check a display is there
+uint8_t HT16K33::probeAddress(uint8_t address)
+{
+	CallBudget budget(this);
+	if (startTransaction() == false)
+		return 5; //Same as a Wire timeout
+
+	if (emulator != NULL)
+		return (emulator->transmit(address, NULL, 0));
+
+	_i2cPort->beginTransmission(address);
+	return (_i2cPort->endTransmission());
+}
+
+//Send all bus transactions to a software model of the displays instead of the Wire port,
+//NULL goes back to the Wire port
+void HT16K33::attachEmulator(HT16K33Emulator *emulatorToUse)
+{
+	emulator = emulatorToUse;
 }
 
 //Write a single byte to the display. This is often a command byte.
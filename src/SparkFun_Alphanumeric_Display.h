@@ -28,6 +28,7 @@ Distributed as-is; no warranty is given.
 #include <Wire.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "SparkFun_Alphanumeric_Display_Font.h"
 
 #define DEFAULT_ADDRESS 0x70 //Default I2C address when A0, A1 are floating
 // #define DEV_ID 0x12          //Device ID that I just made up
@@ -49,6 +50,89 @@ Distributed as-is; no warranty is given.
 #define SEG_M 0x1000
 #define SEG_N 0x2000
 
+#define ALPHA_ALL_SEGMENTS 0x3FFF //All 14 segments of a digit
+#define ALPHA_DIRTY_MERGE_GAP 2   //Clean bytes re-sent rather than starting a new I2C transaction
+#define ALPHA_SCROLL_BUFFER_SIZE 32      //Longest text kept for ALPHA_OVERFLOW_SCROLL
+#define ALPHA_ELLIPSIS_SEGMENTS SEG_D      //Shown in the last digit when text is cut by ALPHA_OVERFLOW_ELLIPSIS
+#define ALPHA_KEY_EVENT_QUEUE_SIZE 8 //Must be a power of two
+#define ALPHA_KEY_SCAN_INTERVAL 10   //Default milliseconds between key scan reads
+#define ALPHA_KEY_DEBOUNCE_COUNT 2   //Default number of matching reads before a key change is reported
+#define ALPHA_NO_PIN 0xFF
+#define ALPHA_NO_DISPLAY 0xFF
+#define ALPHA_NO_DIGIT 0xFF
+//Characters kept with their precomputed RAM stamps, must be a power of two. Each entry
+//takes 10 bytes of RAM. 16 is the smallest that gives every digit its own entry, so
+//counters and clocks always hit. AVR keeps 4, where digits share entries and a miss
+//costs one segment table read from flash.
+#ifndef ALPHA_GLYPH_CACHE_SIZE
+#if defined(ARDUINO_ARCH_AVR)
+#define ALPHA_GLYPH_CACHE_SIZE 4
+#else
+#define ALPHA_GLYPH_CACHE_SIZE 16
+#endif
+#endif
+#define ALPHA_GLYPH_VALID 0x8000 //Set in the segments of a filled cache entry
+
+//Commands posted from other tasks or interrupts, must be a power of two no larger than 64
+#ifndef ALPHA_COMMAND_QUEUE_SIZE
+#if defined(ARDUINO_ARCH_AVR)
+#define ALPHA_COMMAND_QUEUE_SIZE 8
+#else
+#define ALPHA_COMMAND_QUEUE_SIZE 16
+#endif
+#endif
+
+//Double buffered rendering, one core renders while the other transmits. See beginPipeline().
+#if !defined(ALPHA_PIPELINE) && (defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_RP2040))
+#define ALPHA_PIPELINE
+#endif
+#define ALPHA_NO_FRAME 0xFF
+
+//Key scan state takes about 90 bytes of RAM, so it is only built in where RAM is plentiful.
+//On AVR define ALPHA_KEY_SCAN here or in the build flags to use it.
+//#define ALPHA_KEY_SCAN
+#if !defined(ALPHA_KEY_SCAN) && !defined(ARDUINO_ARCH_AVR)
+#define ALPHA_KEY_SCAN
+#endif
+
+#define ALPHA_DEFAULT_LATENCY_BUDGET 25000 //Default microseconds a call may spend waiting on a display
+#define ALPHA_DEFAULT_WIRE_TIMEOUT 0       //I2C timeout put back after each call, 0 is the AVR default of none
+#define ALPHA_DEFAULT_RETRY_BUDGET 20      //Default number of connection attempts
+#define ALPHA_CLOCK_SETTLE_US 1000 //Time for the system oscillator to start before the display is turned on
+
+#define ALPHA_SCAN_FIRST_ADDRESS 0x70 //Range of addresses set by the A0-A2 jumpers
+#define ALPHA_SCAN_LAST_ADDRESS 0x77
+#define ALPHA_SCAN_TIMEOUT_US 1000    //Limit on each probe of a scan, where the Wire library supports it
+
+//Zones take about 100 bytes of RAM, so like key scan they are only built in where RAM is
+//plentiful. On AVR define ALPHA_ZONES here or in the build flags to use them.
+//#define ALPHA_ZONES
+#if !defined(ALPHA_ZONES) && !defined(ARDUINO_ARCH_AVR)
+#define ALPHA_ZONES
+#endif
+#ifndef ALPHA_MAX_ZONES
+#define ALPHA_MAX_ZONES 4 //Independently refreshed digit ranges
+#endif
+
+//Average current of one lit segment at full brightness, used by the power budget.
+//Measure your own boards for a closer estimate.
+#ifndef ALPHA_SEGMENT_MICROAMPS
+#define ALPHA_SEGMENT_MICROAMPS 2500
+#endif
+
+#define ALPHA_STATE_MAGIC 0xA7  //First byte of a saved display state
+#define ALPHA_STATE_VERSION 2   //Layout of the saved state, change it when the layout changes
+
+
+//Error codes reported by getLastError()
+typedef enum
+{
+    ALPHA_SUCCESS = 0,
+    ALPHA_ERROR_NACK_ADDRESS, //Display did not acknowledge its address
+    ALPHA_ERROR_NACK_DATA,    //Display stopped acknowledging during a transfer
+    ALPHA_ERROR_BUS,          //Other I2C failure
+    ALPHA_ERROR_TIMEOUT,      //Latency budget or I2C timeout exceeded
+} alpha_status_t;
 
 typedef enum
 {
@@ -76,13 +160,141 @@ typedef enum
     ALPHA_COLON_OFF = 0b0,
 } alpha_colon_t;
 
+typedef enum
+{
+    ALPHA_ALIGN_LEFT = 0,
+    ALPHA_ALIGN_RIGHT,
+    ALPHA_ALIGN_CENTER,
+} alpha_align_t;
+
+//What to do with text that has more characters than there are digits
+typedef enum
+{
+    ALPHA_OVERFLOW_TRUNCATE = 0, //Show the first characters
+    ALPHA_OVERFLOW_ELLIPSIS,     //Show the first characters and mark the last digit
+    ALPHA_OVERFLOW_SCROLL,       //Keep the text and show the next part on each scrollText() call
+} alpha_overflow_t;
+
 typedef enum
 {
     ALPHA_CMD_SYSTEM_SETUP = 0b00100000,
     ALPHA_CMD_DISPLAY_SETUP = 0b10000000,
     ALPHA_CMD_DIMMING_SETUP = 0b11100000,
+    ALPHA_CMD_ROW_INT_SETUP = 0b10100000,
 } alpha_command_t;
 
+typedef enum
+{
+    ALPHA_REG_KEY_DATA = 0x40, //6 bytes, 13 keys for each of KS0, KS1 and KS2
+    ALPHA_REG_INT_FLAG = 0x60,
+} alpha_register_t;
+
+//A key press or release reported by scanKeys()
+typedef struct
+{
+    uint8_t displayNumber;
+    uint8_t key; //0 to 38, K1-K13 of KS0 are 0-12, KS1 13-25 and KS2 26-38
+    bool pressed;
+} alpha_key_event_t;
+
+//Counters kept by the idle manager
+typedef struct
+{
+    uint32_t standbyCount;   //Number of times the displays were put into standby
+    uint32_t standbyMillis;  //Total time spent in standby
+    uint32_t activeMillis;   //Total time spent with the oscillators running
+    uint16_t lastWakeMicros; //Time taken to restore the displays on the last wake up
+    uint16_t maxWakeMicros;  //Longest wake up seen
+} alpha_power_stats_t;
+
+//Commands for postCommand(). Drawing commands change displayRAM, the others a setup register.
+typedef enum
+{
+    ALPHA_QUEUE_CHAR = 0,       //target: digit, value: character, '.' and ':' light the decimal or colon
+    ALPHA_QUEUE_SEGMENTS,       //target: digit, value: 14-bit segment map
+    ALPHA_QUEUE_DECIMAL,        //target: display, value: 1 for on, 0 for off
+    ALPHA_QUEUE_COLON,          //target: display, value: 1 for on, 0 for off
+    ALPHA_QUEUE_CLEAR,          //target and value unused
+    ALPHA_QUEUE_BRIGHTNESS,     //target: display, value: duty 0 to 15
+    ALPHA_QUEUE_BLINK_RATE,     //target unused, value: alpha_blink_rate_t
+    ALPHA_QUEUE_DISPLAY_ON_OFF, //target unused, value: 1 for on, 0 for off
+} alpha_queue_command_t;
+
+//One slot of the command queue
+typedef struct
+{
+    volatile uint8_t sequence; //Tells producers and the consumer who owns the slot
+    uint8_t command;
+    uint8_t target;
+    uint16_t value;
+} alpha_queue_slot_t;
+
+//Results of bus traffic. While the pipeline runs the transmit core records into its own
+//copy, which the render core takes over between frames.
+typedef struct
+{
+    alpha_status_t lastError;
+    uint8_t faultedDisplays;        //Bitmask of displays whose last transaction failed
+    alpha_status_t displayError[4];
+    uint8_t litSegments[4];         //Segments lit in the last frame sent, counted while the power budget is on
+    uint8_t appliedBrightness[4];   //Dimming register as written, at most brightness[]
+    uint8_t staleDimming;           //Bitmask of displays whose dimming goes out with the next RAM write
+} alpha_bus_state_t;
+
+//Counters kept by the render/transmit pipeline
+typedef struct
+{
+    uint32_t framesSubmitted;   //Frames handed to the transmit core
+    uint32_t framesTransmitted; //Frames sent to the displays
+    uint32_t framesDeferred;    //Submits that found the transmit core still busy
+} alpha_pipeline_stats_t;
+
+//Glyph cache hit and miss counters
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+} alpha_cache_stats_t;
+
+//A cached character. stamp holds the RAM bits of each COM for a digit in the first
+//position of a display, rows 0 and 4, so other positions only need a shift.
+typedef struct
+{
+    uint8_t character;
+    uint16_t segments; //14-bit segment map plus ALPHA_GLYPH_VALID
+    uint8_t stamp[7];
+} alpha_glyph_t;
+
+//A range of digits with its own refresh rate
+typedef struct
+{
+    uint8_t firstDigit;
+    uint8_t length;          //0 when the zone isn't defined
+    uint16_t interval;       //Milliseconds between refreshes, 0 shows changes at the next updateZones()
+    uint32_t nextDue;        //millis() when the zone may next be refreshed
+    bool pending;            //Content changed since the last refresh
+    uint16_t deadlineMisses; //Refreshes shown more than one interval late
+} alpha_zone_t;
+
+//What a digit shows. The decimal and colon are one per display, they are lit when any
+//digit of the display has the attribute, and move with their digit when it is shifted.
+#define ALPHA_DIGIT_DECIMAL 0x4000
+#define ALPHA_DIGIT_COLON 0x8000
+typedef struct
+{
+    uint16_t segments; //14-bit segment map plus ALPHA_DIGIT_DECIMAL and ALPHA_DIGIT_COLON
+    char character;    //Character drawn, '\0' when segments were set directly
+} alpha_digit_t;
+
+//Where the character stream parser is, see parseChar()
+typedef struct
+{
+    uint8_t cursor;    //Digit the next character goes to
+    uint8_t end;       //Digit after the last one that may be drawn
+    uint8_t lastDigit; //Digit that takes a '.' or ':', ALPHA_NO_DIGIT drops them
+    size_t skip;       //Characters passed over before drawing starts
+} alpha_stream_t;
+
 //Structure for defining new character displays
 struct CharDef {
   uint8_t  position;
@@ -90,29 +302,191 @@ struct CharDef {
   struct CharDef * next;
 };
 
+class HT16K33Emulator;
+
 // class HT16K33
 class HT16K33 : public Print
 {
 private:
-    TwoWire *_i2cPort;          //The generic connection to user's chosen I2C hardware
+    TwoWire *_i2cPort = NULL;   //The generic connection to user's chosen I2C hardware
+    HT16K33Emulator *emulator = NULL; //Takes the place of _i2cPort when attached
     uint8_t _deviceAddressLeft; // Address of primary alphanumeric display
     uint8_t _deviceAddressLeftCenter;
     uint8_t _deviceAddressRightCenter;
     uint8_t _deviceAddressRight;
-    uint8_t digitPosition = 0;
+    uint8_t digitPosition = 0;            //Digit write() draws next, 4 * numberOfDisplays once the digits are full
+    uint8_t streamDigit = ALPHA_NO_DIGIT; //Digit of the last character written, which takes a '.' or ':'
     uint8_t numberOfDisplays = 1;
     bool displayOnOff = 0; //Tracks display on/off bit of display setup register
-    bool decimalOnOff = 0;
-    bool colonOnOff = 0;
     uint8_t blinkRate = ALPHA_BLINK_RATE_NOBLINK; //Tracks blink bits in display setup register
+    uint8_t brightness[4] = {15, 15, 15, 15};     //Tracks dimming register of each display
 
     //Enough RAM for up to 4 displays on same I2C bus
+#if defined(ALPHA_PIPELINE)
+    //Two frames, displayRAM points at the one being rendered
+    uint8_t frameRAM[2][16 * 4];
+    uint8_t *displayRAM = frameRAM[0];
+    uint16_t frameDirty[2][4];                //Bytes changed in each frame relative to the one before
+    volatile uint8_t readyFrame = ALPHA_NO_FRAME; //Frame waiting for the transmit core
+    uint8_t renderFrame = 0;
+    bool pipelineEnabled = false;
+    alpha_pipeline_stats_t pipelineStats = {0, 0, 0};
+    alpha_bus_state_t transmitBus;            //Owned by the transmit core while a frame is waiting
+    uint16_t unsentDirty[4] = {0, 0, 0, 0};   //Bytes of failed writes, sent again with the next frame
+
+    bool flushFrame();
+    void collectFrameResults();
+#else
     uint8_t displayRAM[16 * 4];
-    char displayContent[4 * 4 + 1] = "";
+#endif
+    alpha_digit_t displayDigits[4 * 4]; //Content of each digit, displayRAM is drawn from this
+
+    //Command queue
+    alpha_queue_slot_t commandQueue[ALPHA_COMMAND_QUEUE_SIZE];
+    volatile uint8_t commandHead = 0; //Next slot for producers
+    uint8_t commandTail = 0;          //Next slot for the consumer
+    volatile uint16_t commandsDropped = 0;
+    bool commandQueueReady = false;
+
+    void initCommandQueue();
+
+    //Latency limits, all transactions of a call share the budget of the outermost call
+    uint32_t latencyBudget = ALPHA_DEFAULT_LATENCY_BUDGET;
+    uint8_t retryBudget = ALPHA_DEFAULT_RETRY_BUDGET;
+    uint8_t callDepth = 0;      //Calls in progress, see CallBudget
+    uint32_t callStartTime = 0; //micros() when the outermost call started
+#if defined(WIRE_HAS_TIMEOUT)
+    uint32_t wireTimeout = ALPHA_DEFAULT_WIRE_TIMEOUT; //The sketch's own I2C timeout, see setWireTimeout()
+    bool wireTimeoutReset = false;
+    bool wireTimeoutChanged = false; //The port has a shorter timeout that must be put back
+#endif
+
+    class CallBudget;
+    uint32_t remainingBudget();
+    bool startTransaction();
+    void restoreWireTimeout();
+
+    //Errors, faults and the dimming actually sent
+    alpha_bus_state_t bus = {ALPHA_SUCCESS, 0, {ALPHA_SUCCESS, ALPHA_SUCCESS, ALPHA_SUCCESS, ALPHA_SUCCESS}, {0, 0, 0, 0}, {15, 15, 15, 15}, 0};
+    bool faultIsolation = false; //Skip faulted displays instead of sending to them
+
+    alpha_bus_state_t *busState();
+
+    //Hot-plug monitor
+    uint16_t hotPlugInterval = 0; //0 when off
+    uint32_t lastHotPlugCheck = 0;
+    uint8_t nextHotPlugDisplay = 0;
+
+    void recordResult(uint8_t displayNumber, alpha_status_t status);
+    bool isIsolated(uint8_t address);
+    bool restoreDisplays(uint8_t displayMask);
+
+    alpha_status_t probeDisplay(uint8_t displayNumber);
+    void setError(alpha_status_t error);
+    uint8_t lookUpDisplayNumber(uint8_t address);
+
+    //Text layout
+    uint8_t textAlign = ALPHA_ALIGN_LEFT;
+    uint8_t textOverflow = ALPHA_OVERFLOW_TRUNCATE;
+    uint8_t scrollBuffer[ALPHA_SCROLL_BUFFER_SIZE];
+    uint8_t scrollLength = 0;
+    uint8_t scrollPosition = 0;
+
+#if defined(ALPHA_ZONES)
+    //Zones, content waits in zoneDigits until the zone is due
+    alpha_zone_t zones[ALPHA_MAX_ZONES] = {};
+    alpha_digit_t zoneDigits[4 * 4];
+#endif
+
+    //Clock mode
+    uint8_t clockDisplay = ALPHA_NO_DISPLAY;
+    bool clockLeadingZero = true;
 
     //Linked List of character definitions
     struct CharDef * pCharDefList = NULL;
 
+    //Direct mapped glyph cache
+    alpha_glyph_t glyphCache[ALPHA_GLYPH_CACHE_SIZE] = {};
+    alpha_cache_stats_t glyphCacheStats = {0, 0};
+
+    const alpha_glyph_t *lookUpGlyph(uint8_t displayChar);
+    bool stampGlyph(const alpha_glyph_t *glyph, uint8_t digit, bool replace);
+
+    //Bitmask of displayRAM bytes changed since the last flush, one word per display
+    uint16_t dirtyRAM[4] = {0, 0, 0, 0};
+
+    //Canvas clip window, digits are inclusive
+    uint8_t clipFirstDigit = 0;
+    uint8_t clipLastDigit = 4 * 4 - 1;
+    uint16_t clipSegments = ALPHA_ALL_SEGMENTS;
+
+    //Idle manager
+    uint32_t idleTimeout = 0;      //Milliseconds without updates before standby, 0 disables
+    uint32_t lastActivity = 0;     //millis() of the last update
+    uint32_t powerStateChange = 0; //millis() of the last standby entry or wake up
+    bool standby = false;
+    uint8_t clockSettling = 0;     //Bitmask of displays whose oscillator was just started
+    uint8_t clockStopped = 0;      //Bitmask of displays whose oscillator was last turned off
+    uint32_t clockStartTime = 0;   //micros() when the oscillator was last started
+    alpha_power_stats_t powerStats = {0, 0, 0, 0, 0};
+
+    //Power budget, dimming is lowered when a frame would draw more than the budget
+    uint16_t powerBudget = 0; //Milliamps per display, 0 when off
+    uint16_t segmentMicroamps = ALPHA_SEGMENT_MICROAMPS;
+
+#if defined(ALPHA_KEY_SCAN)
+    //Key scan
+    uint8_t keyScanDisplays = 0; //Bitmask of displays with key scan enabled
+    uint8_t keyPending = 0;      //Bitmask of displays with keys down or still debouncing
+    uint8_t keyInterruptPin = ALPHA_NO_PIN; //Shared by all key scan displays
+    volatile bool keyInterruptFlag = false;
+    uint8_t nextKeyDisplay = 0;
+    uint16_t keyScanInterval = ALPHA_KEY_SCAN_INTERVAL;
+    uint8_t keyDebounceCount = ALPHA_KEY_DEBOUNCE_COUNT;
+    uint32_t lastKeyScan = 0;
+    uint16_t keyState[4][3];     //Debounced state of each KS line
+    uint16_t keyCandidate[4][3]; //Last raw read, waiting to become stable
+    uint8_t keyStableCount[4];
+    alpha_key_event_t keyEvents[ALPHA_KEY_EVENT_QUEUE_SIZE];
+    uint8_t keyEventHead = 0;
+    uint8_t keyEventTail = 0;
+    uint16_t keyEventsDropped = 0;
+
+    bool scanKeysSingle(uint8_t displayNumber);
+    void queueKeyEvent(uint8_t displayNumber, uint8_t key, bool pressed);
+#endif
+    bool readRAMOnce(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffSize);
+    uint8_t probeAddress(uint8_t address);
+
+    void noteActivity();
+    void waitForClockSettle();
+    void updatePowerTime();
+    uint8_t limitBrightness(uint8_t displayNumber);
+    bool writeDimming(uint8_t displayNumber, uint8_t duty);
+
+    bool startDisplays(uint8_t addressLeft, uint8_t addressLeftCenter, uint8_t addressRightCenter, uint8_t addressRight,
+                       TwoWire &wirePort, const uint8_t *state, size_t stateSize);
+    bool loadState(const uint8_t *state, size_t stateSize);
+
+    bool layoutText(const uint8_t *text, size_t size, uint8_t firstGlyph);
+    uint8_t parseChar(uint8_t displayChar, alpha_digit_t *content, alpha_stream_t *stream);
+    uint8_t getCharPosition(uint8_t displayChar);
+    void setRAMBit(uint8_t displayNumber, uint8_t adr, bool turnOn);
+    void setDisplayAttribute(uint8_t displayNumber, uint16_t attribute, bool turnOn);
+    void updateAttributes(uint8_t displayNumber);
+    void loadDigits(uint8_t displayNumber, uint8_t attributes);
+    bool redrawDigits();
+#if defined(ALPHA_ZONES)
+    void markZonePending(alpha_zone_t *zone);
+#endif
+
+    bool stampDigit(uint16_t segmentsToTurnOn, uint16_t segmentsToChange, uint8_t digit);
+    void writeDigitRAM(uint16_t segmentsToTurnOn, uint16_t segmentsToChange, uint8_t digit);
+    uint16_t readDigitRAM(uint8_t digit);
+    bool clipCanvas(uint8_t digit, uint16_t &segmentsToChange);
+    bool updateDisplayRAM(uint8_t displayNumber, uint16_t bytesToWrite);
+    bool writeDisplayBytes(uint8_t displayNumber, uint8_t *ram, uint16_t bytesToWrite);
+
 public:
     //Device status
     bool begin(uint8_t addressLeft = DEFAULT_ADDRESS,
@@ -120,11 +494,40 @@ public:
                uint8_t addressRightCenter = DEFAULT_NOTHING_ATTACHED,
                uint8_t addressRight = DEFAULT_NOTHING_ATTACHED,
                TwoWire &wirePort = Wire); // Sets the address of the device and opens the Wire port for communication
+    bool beginWithState(const uint8_t *state, size_t stateSize,
+                        uint8_t addressLeft = DEFAULT_ADDRESS,
+                        uint8_t addressLeftCenter = DEFAULT_NOTHING_ATTACHED,
+                        uint8_t addressRightCenter = DEFAULT_NOTHING_ATTACHED,
+                        uint8_t addressRight = DEFAULT_NOTHING_ATTACHED,
+                        TwoWire &wirePort = Wire); // Like begin(), but shows a saved state instead of clearing the displays
     bool isConnected(uint8_t displayNumber);
     bool initialize();
     // bool checkDeviceID(uint8_t displayNumber);
     uint8_t lookUpDisplayAddress(uint8_t displayNumber);
 
+    //Saved state, for keeping the displays across a restart in EEPROM or flash
+    size_t getStateSize();
+    bool saveState(uint8_t *buffer, size_t bufferSize);
+    bool restoreState(const uint8_t *state, size_t stateSize);
+
+    //Latency limits and errors
+    void setLatencyBudget(uint32_t budgetMicros, uint8_t retries = ALPHA_DEFAULT_RETRY_BUDGET);
+    void setWireTimeout(uint32_t timeoutMicros, bool resetOnTimeout = false);
+    alpha_status_t getLastError();
+
+    //Per display faults
+    uint8_t getFaultedDisplays();
+    alpha_status_t getDisplayError(uint8_t displayNumber);
+    void setFaultIsolation(bool skipFaultedDisplays);
+    uint8_t recoverDisplays();
+
+    //Discovery and hot-plug
+    uint8_t scanForDisplays(uint8_t *addresses, uint8_t maxAddresses, TwoWire &wirePort = Wire);
+    bool beginAuto(TwoWire &wirePort = Wire);
+    void enableHotPlug(uint16_t intervalMillis);
+    void disableHotPlug();
+    uint8_t checkHotPlug();
+
     //Display configuration functions
     bool clear();
     bool setBrightness(uint8_t duty);
@@ -144,15 +547,55 @@ public:
     bool enableSystemClockSingle(uint8_t displayNumber);
     bool disableSystemClockSingle(uint8_t displayNumber);
 
+    //Idle manager
+    void setIdleTimeout(uint32_t timeoutMillis);
+    bool checkIdle();
+    bool enterStandby();
+    bool wake();
+    bool isStandby();
+    alpha_power_stats_t getPowerStats();
+    void resetPowerStats();
+
+    //Power budget
+    bool setPowerBudget(uint16_t milliampsPerDisplay, uint16_t microampsPerSegment = ALPHA_SEGMENT_MICROAMPS);
+    uint32_t getEstimatedCurrent(uint8_t displayNumber = ALPHA_NO_DISPLAY);
+    uint8_t getAppliedBrightness(uint8_t displayNumber);
+
     //Light up functions
     void illuminateSegment(uint8_t segment, uint8_t digit);
     void illuminateChar(uint16_t disp, uint8_t digit);
     void printChar(uint8_t displayChar, uint8_t digit);
     bool updateDisplay();
+    bool updateDisplayDirty();
+
+#if defined(ALPHA_PIPELINE)
+    //Render/transmit pipeline
+    bool beginPipeline();
+    void endPipeline();
+    bool submitFrame();
+    bool transmitFrame();
+    alpha_pipeline_stats_t getPipelineStats();
+#endif
+
+    //Canvas functions - these only change displayRAM, call updateDisplayDirty() to send a batch
+    bool segmentOn(uint8_t segment, uint8_t digit);
+    bool segmentOff(uint8_t segment, uint8_t digit);
+    bool toggleSegment(uint8_t segment, uint8_t digit);
+    bool setSegmentOnOff(uint8_t segment, uint8_t digit, bool turnOnSegment);
+    bool setDigitSegments(uint16_t segmentsToTurnOn, uint8_t digit);
+    bool clearDigit(uint8_t digit);
+    uint16_t getDigitSegments(uint8_t digit);
+    uint8_t drawBar(uint8_t startDigit, uint8_t length, uint16_t segmentsToTurnOn = SEG_G | SEG_I);
+    bool drawLevelMeter(uint8_t startDigit, uint8_t numDigits, uint8_t level,
+                        uint16_t lowerSegments = SEG_G, uint16_t upperSegments = SEG_I);
+    void setClipWindow(uint8_t firstDigit, uint8_t lastDigit, uint16_t segmentMask = ALPHA_ALL_SEGMENTS);
+    void resetClipWindow();
 
     //Define Character Segment Map
     bool defineChar(uint8_t displayChar, uint16_t segmentsToTurnOn);
     uint16_t getSegmentsToTurnOn (uint8_t charPos);
+    alpha_cache_stats_t getGlyphCacheStats();
+    void resetGlyphCacheStats();
 
     //Colon and decimal
     bool decimalOn();
@@ -167,6 +610,52 @@ public:
     bool colonOffSingle(uint8_t displayNumber);
     bool setColonOnOff(uint8_t displayNumber, bool turnOnColon);
 
+#if defined(ALPHA_KEY_SCAN)
+    //Key scan
+    bool enableKeyScan(uint8_t displayNumber, uint8_t interruptPin = ALPHA_NO_PIN);
+    bool disableKeyScan(uint8_t displayNumber);
+    void setKeyScanInterval(uint16_t intervalMillis);
+    void setKeyDebounce(uint8_t matchingReads);
+    void keyInterrupt();
+    bool scanKeys();
+    uint8_t keyEventsAvailable();
+    bool readKeyEvent(alpha_key_event_t *event);
+    bool isKeyPressed(uint8_t displayNumber, uint8_t key);
+    uint16_t getKeyEventsDropped();
+#endif
+
+#if defined(ALPHA_ZONES)
+    //Zones - digit ranges refreshed at their own rate, due zones go out together
+    bool defineZone(uint8_t zone, uint8_t firstDigit, uint8_t length, uint16_t intervalMillis = 0);
+    bool setZoneText(uint8_t zone, const char *text);
+    bool setZoneChar(uint8_t zone, uint8_t position, uint8_t displayChar);
+    bool updateZones();
+    uint16_t getZoneDeadlineMisses(uint8_t zone);
+#endif
+
+    //Clock mode
+    bool beginClock(uint8_t displayNumber = 0, bool leadingZero = true);
+    bool setClockTime(uint8_t hours, uint8_t minutes);
+    bool setClockColon(bool turnOnColon);
+    bool toggleClockColon();
+
+    //Text layout
+    void setTextLayout(alpha_align_t align, alpha_overflow_t overflow = ALPHA_OVERFLOW_TRUNCATE);
+    bool scrollText();
+
+    //Messages rendered at compile time with ALPHA_IMAGE()
+    template <uint8_t displays>
+    bool displayImage(const alpha_image_t<displays> &image)
+    {
+        return displayImage(image.ram, image.text, image.attributes, pgm_read_byte(&image.length), displays);
+    }
+    bool displayImage(const uint8_t *ram, const char *text, const uint8_t *attributes, uint8_t length, uint8_t displays);
+
+    //Command queue - any task or interrupt may post, one task processes
+    bool postCommand(alpha_queue_command_t command, uint8_t target = 0, uint16_t value = 0);
+    bool processCommands();
+    uint16_t getCommandsDropped();
+
     bool shiftRight(uint8_t shiftAmt = 1);
     bool shiftLeft(uint8_t shiftAmt = 1);
 
@@ -180,6 +669,7 @@ public:
     // bool read(uint8_t reg, uint8_t data);
     bool writeRAM(uint8_t address, uint8_t reg, uint8_t *buff, uint8_t buffSize);
     bool writeRAM(uint8_t reg, uint8_t data);
+    void attachEmulator(HT16K33Emulator *emulatorToUse);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,287 @@
+/******************************************************************************
+SparkFun_Alphanumeric_Display_Font.h
+SparkFun Alphanumeric Display Library Character Map
+SparkFun Electronics
+Original Creation Date: October 18, 2026
+https://github.com/sparkfun/SparkFun_Alphanumeric_Display_Arduino_Library
+
+Pickup a board here: https://sparkle.sparkfun.com/sparkle/storefront_products/16391
+
+This file holds the segment table used by the HT16K33 class and the tools that render
+a fixed message into display RAM at compile time. A rendered message is kept in flash
+and shown with HT16K33::displayImage(), without any character lookup at run time:
+
+    ALPHA_IMAGE(errorImage, 1, "ERR.");
+    display.displayImage(errorImage);
+
+Images use the built in characters. Characters changed with defineChar() are only
+known at run time, so they are not applied. Text is left aligned and cut to the digits
+of the image; a '.' or ':' lights the decimal or colon of the display the character
+before it is on.
+
+This code is beerware; if you see me (or any other SparkFun employee) at the
+local, and you've found our code helpful, please buy us a round!
+
+Distributed as-is; no warranty is given.
+******************************************************************************/
+#ifndef __SparkFun_Alphanumeric_Display_Font_H__
+#define __SparkFun_Alphanumeric_Display_Font_H__
+
+#include <Arduino.h>
+
+/*--------------------------- Character Map ----------------------------------*/
+#define SFE_ALPHANUM_UNKNOWN_CHAR 95
+
+//This is the lookup table of segments for various characters
+//For AVR architecture, use PROGMEM. It is constexpr so images can be built from it.
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/pgmspace.h>
+static constexpr uint16_t PROGMEM alphanumeric_segs[96]{
+#else
+static constexpr uint16_t alphanumeric_segs[96]{
+#endif
+    //nmlkjihgfedcba
+    0b00000000000000, //' ' (space)
+    0b00001000001000, //'!'  - added to map
+    0b00001000000010, //'"' - added to map
+     0b1001101001110,  //'#'
+    0b1001101101101,  //'$'
+    0b10010000100100, //'%'
+    0b110011011001,   //'&'
+    0b1000000000,      //'''
+    0b111001,         //'('
+    0b1111,           //')'
+    0b11111010000000, //'*'
+    0b1001101000000,  //'+'
+    0b10000000000000, //','
+    0b101000000,      //'-'
+    0b00000000000000, //'.' - changed to blank
+    0b10010000000000, //'/'
+    0b111111,         //'0'
+    0b10000000110,      //'1'
+    0b101011011,      //'2'
+    0b101001111,      //'3'
+    0b101100110,      //'4'
+    0b101101101,      //'5'
+    0b101111101,      //'6'
+    0b1010000000001,  //'7'
+    0b101111111,      //'8'
+    0b101100111,      //'9'
+    0b00000000000000, //':' - changed to blank
+    0b10001000000000, //';'
+    0b110000000000,   //'<'
+    0b101001000,      //'='
+    0b01000010000000, //'>'
+    0b01000100000011, //'?' - Added to map
+    0b00001100111011, //'@' - Added to map
+    0b101110111,      //'A'
+    0b1001100001111,  //'B'
+    0b111001,         //'C'
+    0b1001000001111,  //'D'
+    0b101111001,      //'E'
+    0b101110001,      //'F'
+    0b100111101,      //'G'
+    0b101110110,      //'H'
+    0b1001000001001,  //'I'
+    0b11110,          //'J'
+    0b110001110000,   //'K'
+    0b111000,         //'L'
+    0b10010110110,      //'M'
+    0b100010110110,   //'N'
+    0b111111,         //'O'
+    0b101110011,      //'P'
+    0b100000111111,   //'Q'
+    0b100101110011,   //'R'
+    0b110001101,      //'S'
+    0b1001000000001,  //'T'
+    0b111110,         //'U'
+    0b10010000110000, //'V'
+    0b10100000110110, //'W'
+    0b10110010000000, //'X'
+    0b1010010000000,  //'Y'
+    0b10010000001001, //'Z'
+    0b111001,         //'['
+    0b100010000000,   //'\'
+    0b1111,           //']'
+    0b10100000000000, //'^' - Added to map
+    0b1000,              //'_'
+    0b10000000,          //'`'
+    0b101011111,      //'a'
+    0b100001111000,   //'b'
+    0b101011000,      //'c'
+    0b10000100001110, //'d'
+    0b1111001,        //'e'
+    0b1110001,        //'f'
+    0b110001111,      //'g'
+    0b101110100,      //'h'
+    0b1000000000000,  //'i'
+    0b1110,           //'j'
+    0b1111000000000,  //'k'
+    0b1001000000000,  //'l'
+    0b1000101010100,  //'m'
+    0b100001010000,   //'n'
+    0b101011100,      //'o'
+    0b10001110001,      //'p'
+    0b100101100011,   //'q'
+    0b1010000,        //'r'
+    0b110001101,      //'s'
+    0b1111000,        //'t'
+    0b11100,          //'u'
+    0b10000000010000, //'v'
+    0b10100000010100, //'w'
+    0b10110010000000, //'x'
+    0b1100001110,      //'y'
+    0b10010000001001, //'z'
+    0b10000011001001, //'{'
+    0b1001000000000,  //'|'
+    0b110100001001,   //'}'
+    0b00000101010010, //'~' - Added to map
+    0b11111111111111, //Unknown character (DEL or RUBOUT)
+};
+
+/*--------------------------- Compile time images ----------------------------*/
+
+//RAM and digit characters of a message on some number of displays
+template <uint8_t displays>
+struct alpha_image_t
+{
+    uint8_t ram[16 * displays];
+    char text[4 * displays]; //Character on each digit, so the message can be shifted
+    uint8_t attributes[displays]; //Digits with the decimal in bits 0-3 and the colon in bits 4-7
+    uint8_t length;             //Digits used by the message
+};
+
+//Lists of indexes to expand the bytes of an image from
+template <uint16_t... index>
+struct alpha_index_list
+{
+};
+
+template <uint16_t count, uint16_t... index>
+struct alpha_make_index_list : alpha_make_index_list<count - 1, count - 1, index...>
+{
+};
+
+template <uint16_t... index>
+struct alpha_make_index_list<0, index...>
+{
+    typedef alpha_index_list<index...> type;
+};
+
+//Characters that set the decimal or colon instead of taking a digit
+constexpr bool alphaIsAttribute(char c)
+{
+    return (c == '.' || c == ':');
+}
+
+//Same as HT16K33::getCharPosition()
+constexpr uint8_t alphaCharPosition(char c)
+{
+    return (c == ' ') ? 0 : (c >= '!' && c <= '~') ? c - '!' + 1 : SFE_ALPHANUM_UNKNOWN_CHAR;
+}
+
+//Index in the text of the character on a digit, or -1 if the text is too short
+constexpr int alphaTextIndex(const char *text, int pos, int digit)
+{
+    return (text[pos] == '\0') ? -1 : alphaIsAttribute(text[pos]) ? alphaTextIndex(text, pos + 1, digit) : (digit == 0) ? pos : alphaTextIndex(text, pos + 1, digit - 1);
+}
+
+//Number of digits the text before pos takes
+constexpr int alphaDigitsBefore(const char *text, int pos)
+{
+    return (pos == 0) ? 0 : alphaDigitsBefore(text, pos - 1) + (alphaIsAttribute(text[pos - 1]) ? 0 : 1);
+}
+
+//A '.' or ':' goes with the digit before it, or with the first digit if it leads the text
+constexpr int alphaAttributeDigit(const char *text, int pos)
+{
+    return (alphaDigitsBefore(text, pos) == 0) ? 0 : alphaDigitsBefore(text, pos) - 1;
+}
+
+//Is there a c going with a digit of this display, from pos on
+constexpr bool alphaHasAttribute(const char *text, int pos, char c, uint8_t displayNumber)
+{
+    return (text[pos] == '\0') ? false : ((text[pos] == c && alphaAttributeDigit(text, pos) / 4 == displayNumber) || alphaHasAttribute(text, pos + 1, c, displayNumber));
+}
+
+//Is there a c going with a digit, from pos on
+constexpr bool alphaDigitHasAttribute(const char *text, int pos, char c, int digit)
+{
+    return (text[pos] == '\0') ? false : ((text[pos] == c && alphaAttributeDigit(text, pos) == digit) || alphaDigitHasAttribute(text, pos + 1, c, digit));
+}
+
+//Attribute bits of one digit, shifted to its place in alpha_image_t::attributes
+constexpr uint8_t alphaDigitAttributes(const char *text, int digit)
+{
+    return ((alphaDigitHasAttribute(text, 0, '.', digit) ? 0x01 : 0) | (alphaDigitHasAttribute(text, 0, ':', digit) ? 0x10 : 0)) << (digit % 4);
+}
+
+constexpr uint8_t alphaImageAttributes(const char *text, uint8_t displayNumber)
+{
+    return alphaDigitAttributes(text, displayNumber * 4 + 0) | alphaDigitAttributes(text, displayNumber * 4 + 1) |
+           alphaDigitAttributes(text, displayNumber * 4 + 2) | alphaDigitAttributes(text, displayNumber * 4 + 3);
+}
+
+//Number of digits the text from pos on takes
+constexpr int alphaTextDigits(const char *text, int pos)
+{
+    return (text[pos] == '\0') ? 0 : (alphaIsAttribute(text[pos]) ? 0 : 1) + alphaTextDigits(text, pos + 1);
+}
+
+constexpr char alphaDigitChar(const char *text, int digit)
+{
+    return (alphaTextIndex(text, 0, digit) < 0) ? ' ' : text[alphaTextIndex(text, 0, digit)];
+}
+
+constexpr uint16_t alphaDigitSegments(const char *text, int digit)
+{
+    return (alphaTextIndex(text, 0, digit) < 0) ? 0 : alphanumeric_segs[alphaCharPosition(text[alphaTextIndex(text, 0, digit)])];
+}
+
+//Segments H to N in COM order, as in HT16K33::stampDigit()
+constexpr uint8_t alphaHighSegments(uint16_t segments)
+{
+    return ((segments >> 8) & 0x01) | ((segments >> 6) & 0x02) | ((segments >> 7) & 0x7C);
+}
+
+//Bits of a COM byte for the digit on a row
+constexpr uint8_t alphaComBits(uint16_t segments, uint8_t com, uint8_t row)
+{
+    return (((segments >> com) & 0b1) << row) | (((alphaHighSegments(segments) >> com) & 0b1) << (row + 4));
+}
+
+//One byte of display RAM. COM0 to COM6 are on the even addresses, the colon is
+//bit 0 of address 1 and the decimal bit 0 of address 3.
+constexpr uint8_t alphaImageByte(const char *text, uint8_t displayNumber, uint8_t adr)
+{
+    return (adr == 1) ? (alphaHasAttribute(text, 0, ':', displayNumber) ? 1 : 0)
+         : (adr == 3) ? (alphaHasAttribute(text, 0, '.', displayNumber) ? 1 : 0)
+         : ((adr & 1) || adr >= 14) ? 0
+         : alphaComBits(alphaDigitSegments(text, displayNumber * 4 + 0), adr / 2, 0) |
+               alphaComBits(alphaDigitSegments(text, displayNumber * 4 + 1), adr / 2, 1) |
+               alphaComBits(alphaDigitSegments(text, displayNumber * 4 + 2), adr / 2, 2) |
+               alphaComBits(alphaDigitSegments(text, displayNumber * 4 + 3), adr / 2, 3);
+}
+
+template <uint8_t displays, uint16_t... adr, uint16_t... digit, uint16_t... displayNumber>
+constexpr alpha_image_t<displays> alphaBuildImage(const char *text, alpha_index_list<adr...>, alpha_index_list<digit...>, alpha_index_list<displayNumber...>)
+{
+    return alpha_image_t<displays>{
+        {alphaImageByte(text, adr / 16, adr % 16)...},
+        {alphaDigitChar(text, digit)...},
+        {alphaImageAttributes(text, displayNumber)...},
+        (uint8_t)((alphaTextDigits(text, 0) < 4 * displays) ? alphaTextDigits(text, 0) : 4 * displays)};
+}
+
+//Render a string literal for some number of displays
+template <uint8_t displays, size_t size>
+constexpr alpha_image_t<displays> alphaImage(const char (&text)[size])
+{
+    static_assert(displays >= 1 && displays <= 4, "An image covers 1 to 4 displays");
+    return alphaBuildImage<displays>(text, typename alpha_make_index_list<16 * displays>::type(), typename alpha_make_index_list<4 * displays>::type(), typename alpha_make_index_list<displays>::type());
+}
+
+//Declare a message rendered at compile time and stored in flash
+#define ALPHA_IMAGE(name, displays, text) static constexpr alpha_image_t<displays> name PROGMEM = alphaImage<displays>(text)
+
+#endif
@@ -0,0 +1,362 @@
+/******************************************************************************
+SparkFun_Alphanumeric_Emulator.cpp
+SparkFun Alphanumeric Display Library Emulator Source File
+SparkFun Electronics
+Original Creation Date: October 18, 2026
+https://github.com/sparkfun/SparkFun_Alphanumeric_Display_Arduino_Library
+
+Pickup a board here: https://sparkle.sparkfun.com/sparkle/storefront_products/16391
+
+This file implements the HT16K33Emulator class. Only the commands the library sends
+are modeled: display RAM writes, system setup, display setup, dimming, ROW/INT setup
+and reads of display RAM, key RAM and the INT flag.
+
+Bus time counts each bit of a transaction at the set clock: start, address and
+acknowledge, nine bits for each data byte and stop. Clock stretching and time between
+transactions are not counted.
+
+This code is beerware; if you see me (or any other SparkFun employee) at the
+local, and you've found our code helpful, please buy us a round!
+
+Distributed as-is; no warranty is given.
+******************************************************************************/
+
+#include <SparkFun_Alphanumeric_Display.h>
+#include <SparkFun_Alphanumeric_Emulator.h>
+
+/*---------------------------- Emulated displays -------------------------------*/
+
+bool HT16K33Emulator::addDisplay(uint8_t address)
+{
+	if (numberOfChips >= ALPHA_EMULATOR_MAX_DISPLAYS || findChip(address) != NULL)
+		return false;
+
+	alpha_emulated_chip_t *chip = &chips[numberOfChips++];
+	chip->address = address;
+	chip->connected = true;
+	resetChip(chip);
+	return true;
+}
+
+//A display plugged back in starts from the power on state
+bool HT16K33Emulator::setConnected(uint8_t address, bool connected)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL)
+		return false;
+
+	if (connected == true && chip->connected == false)
+		resetChip(chip);
+	chip->connected = connected;
+	return true;
+}
+
+void HT16K33Emulator::reset()
+{
+	for (uint8_t i = 0; i < numberOfChips; i++)
+		resetChip(&chips[i]);
+}
+
+//Power on state from the datasheet: oscillator and display off, full duty
+void HT16K33Emulator::resetChip(alpha_emulated_chip_t *chip)
+{
+	memset(chip->ram, 0, sizeof(chip->ram));
+	memset(chip->keyData, 0, sizeof(chip->keyData));
+	chip->intFlag = 0;
+	chip->pointer = 0;
+	chip->oscillatorOn = false;
+	chip->displayOn = false;
+	chip->blinkRate = ALPHA_BLINK_RATE_NOBLINK;
+	chip->dimming = 15;
+	chip->rowIntSetup = ALPHA_CMD_ROW_INT_SETUP;
+}
+
+alpha_emulated_chip_t *HT16K33Emulator::findChip(uint8_t address)
+{
+	for (uint8_t i = 0; i < numberOfChips; i++)
+	{
+		if (chips[i].address == address)
+			return &chips[i];
+	}
+	return NULL;
+}
+
+/*-------------------------------- Bus side ------------------------------------*/
+
+//A write transaction. With no data this is the address probe of isConnected().
+uint8_t HT16K33Emulator::transmit(uint8_t address, const uint8_t *data, uint8_t size)
+{
+	countTransaction(size);
+
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL || chip->connected == false)
+		return ALPHA_EMULATOR_NACK_ADDRESS;
+
+	if (size == 0)
+		return ALPHA_EMULATOR_ACK;
+
+	uint8_t command = data[0];
+	switch (command & 0xF0)
+	{
+	case 0x00: //Display RAM, the address wraps within the 16 bytes
+		for (uint8_t i = 1; i < size; i++)
+			chip->ram[(command + i - 1) & 0x0F] = data[i];
+		break;
+	case ALPHA_CMD_SYSTEM_SETUP:
+		chip->oscillatorOn = command & 0b1;
+		break;
+	case ALPHA_CMD_DISPLAY_SETUP:
+		chip->displayOn = command & 0b1;
+		chip->blinkRate = (command >> 1) & 0b11;
+		break;
+	case ALPHA_CMD_DIMMING_SETUP:
+		chip->dimming = command & 0x0F;
+		break;
+	case ALPHA_CMD_ROW_INT_SETUP:
+		chip->rowIntSetup = command;
+		break;
+	default: //Key RAM and INT flag addresses only set up a read
+		break;
+	}
+
+	chip->pointer = command;
+	return ALPHA_EMULATOR_ACK;
+}
+
+//A read transaction starting at the address of the last write, returns the bytes read
+uint8_t HT16K33Emulator::receive(uint8_t address, uint8_t *buff, uint8_t size)
+{
+	countTransaction(size);
+
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL || chip->connected == false)
+		return 0;
+
+	for (uint8_t i = 0; i < size; i++)
+	{
+		uint8_t pointer = chip->pointer + i;
+
+		if (chip->pointer < 0x10)
+			buff[i] = chip->ram[pointer & 0x0F];
+		else if (pointer >= ALPHA_REG_KEY_DATA && pointer < ALPHA_REG_KEY_DATA + 6)
+			buff[i] = chip->keyData[pointer - ALPHA_REG_KEY_DATA];
+		else if (pointer == ALPHA_REG_INT_FLAG)
+			buff[i] = chip->intFlag;
+		else
+			buff[i] = 0;
+	}
+
+	//Reading the flag clears it, the next key scan sets it again while keys are down
+	if (chip->pointer == ALPHA_REG_INT_FLAG)
+	{
+		chip->intFlag = 0;
+		for (uint8_t x = 0; x < 6; x++)
+		{
+			if (chip->keyData[x] != 0)
+				chip->intFlag = 1;
+		}
+	}
+
+	return size;
+}
+
+void HT16K33Emulator::countTransaction(uint8_t dataBytes)
+{
+	//Start, address byte and acknowledge, data bytes and acknowledges, stop
+	uint32_t bits = 1 + 9 + 9 * (uint32_t)dataBytes + 1;
+	busBits += bits;
+	transactions++;
+	bytes += dataBytes;
+
+	if (realTime == true)
+		delayMicroseconds(bits * 1000000 / busClock);
+}
+
+/*--------------------------------- Bus time -----------------------------------*/
+
+void HT16K33Emulator::setBusClock(uint32_t clockHz)
+{
+	if (clockHz == 0)
+		clockHz = ALPHA_EMULATOR_DEFAULT_CLOCK; //Error check
+	busClock = clockHz;
+}
+
+//Make each transaction block for its bus time, for measuring code that overlaps with the bus
+void HT16K33Emulator::setRealTime(bool waitForBus)
+{
+	realTime = waitForBus;
+}
+
+uint32_t HT16K33Emulator::getBusMicros()
+{
+	return ((uint64_t)busBits * 1000000 / busClock);
+}
+
+uint32_t HT16K33Emulator::getTransactions()
+{
+	return transactions;
+}
+
+uint32_t HT16K33Emulator::getBytes()
+{
+	return bytes;
+}
+
+void HT16K33Emulator::resetCounters()
+{
+	busBits = 0;
+	transactions = 0;
+	bytes = 0;
+}
+
+/*-------------------------------- Chip state ----------------------------------*/
+
+const uint8_t *HT16K33Emulator::getRAM(uint8_t address)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL)
+		return NULL;
+	return chip->ram;
+}
+
+//The segments only light with both the oscillator and the display on
+bool HT16K33Emulator::isDisplayLit(uint8_t address)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	return (chip != NULL && chip->connected == true && chip->oscillatorOn == true && chip->displayOn == true);
+}
+
+uint8_t HT16K33Emulator::getDimming(uint8_t address)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL)
+		return 0;
+	return chip->dimming;
+}
+
+uint8_t HT16K33Emulator::getBlinkRate(uint8_t address)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL)
+		return ALPHA_BLINK_RATE_NOBLINK;
+	return chip->blinkRate;
+}
+
+//14-bit segment map of a digit (0 to 3) as stored in RAM, the reverse of HT16K33::stampDigit()
+uint16_t HT16K33Emulator::getDigitSegments(uint8_t address, uint8_t digit)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL || digit > 3)
+		return 0;
+
+	uint16_t low = 0;
+	uint8_t high = 0;
+	for (uint8_t com = 0; com < 7; com++)
+	{
+		low |= ((chip->ram[com * 2] >> digit) & 0b1) << com;
+		high |= ((chip->ram[com * 2] >> (digit + 4)) & 0b1) << com;
+	}
+
+	//COM0 of the high rows is I, COM1 is H, COM2 to COM6 are J to N
+	return low | ((high & 0x01) << 8) | ((high & 0x02) << 6) | ((uint16_t)(high & 0x7C) << 7);
+}
+
+//Press or release a key, numbered as in HT16K33::readKeyEvent()
+bool HT16K33Emulator::setKey(uint8_t address, uint8_t key, bool pressed)
+{
+	alpha_emulated_chip_t *chip = findChip(address);
+	if (chip == NULL || key >= 39)
+		return false;
+
+	uint8_t adr = (key / 13) * 2 + (key % 13) / 8;
+	uint8_t bit = (key % 13) % 8;
+
+	if (pressed == true)
+	{
+		chip->keyData[adr] |= 1 << bit;
+		chip->intFlag = 1;
+	}
+	else
+		chip->keyData[adr] &= ~(1 << bit);
+
+	return true;
+}
+
+/*--------------------------------- Drawing ------------------------------------*/
+
+//Each digit is five characters wide:
+//   ---      A
+//  |\|/|     F H J K B
+//   - -      G I
+//  |/|\|     E N M L C
+//   ---      D
+//The colon and decimal sit between the second and third digit.
+void HT16K33Emulator::render(Print &out)
+{
+	char line[ALPHA_EMULATOR_MAX_DISPLAYS * 26 + 1];
+
+	for (uint8_t y = 0; y < 5; y++)
+	{
+		uint8_t x = 0;
+
+		for (uint8_t i = 0; i < numberOfChips; i++)
+		{
+			bool lit = isDisplayLit(chips[i].address);
+
+			for (uint8_t digit = 0; digit < 4; digit++)
+			{
+				uint16_t s = lit ? getDigitSegments(chips[i].address, digit) : 0;
+				switch (y)
+				{
+				case 0:
+					memcpy(line + x, (s & SEG_A) ? " --- " : "     ", 5);
+					x += 5;
+					break;
+				case 1:
+					line[x++] = (s & SEG_F) ? '|' : ' ';
+					line[x++] = (s & SEG_H) ? '\\' : ' ';
+					line[x++] = (s & SEG_J) ? '|' : ' ';
+					line[x++] = (s & SEG_K) ? '/' : ' ';
+					line[x++] = (s & SEG_B) ? '|' : ' ';
+					break;
+				case 2:
+					line[x++] = ' ';
+					line[x++] = (s & SEG_G) ? '-' : ' ';
+					line[x++] = ' ';
+					line[x++] = (s & SEG_I) ? '-' : ' ';
+					line[x++] = ' ';
+					break;
+				case 3:
+					line[x++] = (s & SEG_E) ? '|' : ' ';
+					line[x++] = (s & SEG_N) ? '/' : ' ';
+					line[x++] = (s & SEG_M) ? '|' : ' ';
+					line[x++] = (s & SEG_L) ? '\\' : ' ';
+					line[x++] = (s & SEG_C) ? '|' : ' ';
+					break;
+				default:
+					memcpy(line + x, (s & SEG_D) ? " --- " : "     ", 5);
+					x += 5;
+					break;
+				}
+
+				if (digit == 1)
+				{
+					bool colon = lit && (chips[i].ram[1] & 0b1);
+					bool decimal = lit && (chips[i].ram[3] & 0b1);
+					if ((y == 1 || y == 3) && colon)
+						line[x++] = ':';
+					else if (y == 4 && decimal)
+						line[x++] = '.';
+					else
+						line[x++] = ' ';
+				}
+				else
+					line[x++] = ' ';
+			}
+			line[x++] = ' ';
+		}
+
+		line[x] = '\0';
+		out.println(line);
+	}
+}
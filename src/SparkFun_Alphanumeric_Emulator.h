@@ -0,0 +1,95 @@
+/******************************************************************************
+SparkFun_Alphanumeric_Emulator.h
+SparkFun Alphanumeric Display Library Emulator Header File
+SparkFun Electronics
+Original Creation Date: October 18, 2026
+https://github.com/sparkfun/SparkFun_Alphanumeric_Display_Arduino_Library
+
+Pickup a board here: https://sparkle.sparkfun.com/sparkle/storefront_products/16391
+
+This file prototypes the HT16K33Emulator class, a software model of the HT16K33 for
+testing without hardware. Attach it with HT16K33::attachEmulator() and every bus
+transaction of the library goes to the model instead of the Wire port. The model
+decodes the commands, keeps display and key RAM, counts the time the transactions
+would take on the bus and draws the digits as ASCII art.
+
+This code is beerware; if you see me (or any other SparkFun employee) at the
+local, and you've found our code helpful, please buy us a round!
+
+Distributed as-is; no warranty is given.
+******************************************************************************/
+#ifndef __SparkFun_Alphanumeric_Emulator_H__
+#define __SparkFun_Alphanumeric_Emulator_H__
+
+#include <Arduino.h>
+
+#define ALPHA_EMULATOR_MAX_DISPLAYS 4
+#define ALPHA_EMULATOR_DEFAULT_CLOCK 100000 //Standard mode I2C, in Hz
+
+//Wire library results returned by the bus functions
+#define ALPHA_EMULATOR_ACK 0
+#define ALPHA_EMULATOR_NACK_ADDRESS 2
+
+//One emulated HT16K33
+typedef struct
+{
+    uint8_t address;
+    bool connected; //Doesn't answer while false
+    uint8_t ram[16];
+    uint8_t keyData[6];
+    uint8_t intFlag;
+    uint8_t pointer; //Address byte of the last write, reads start here
+    bool oscillatorOn;
+    bool displayOn;
+    uint8_t blinkRate;
+    uint8_t dimming;
+    uint8_t rowIntSetup;
+} alpha_emulated_chip_t;
+
+class HT16K33Emulator
+{
+private:
+    alpha_emulated_chip_t chips[ALPHA_EMULATOR_MAX_DISPLAYS];
+    uint8_t numberOfChips = 0;
+
+    //Bus counters
+    uint32_t busClock = ALPHA_EMULATOR_DEFAULT_CLOCK;
+    uint32_t busBits = 0;
+    uint32_t transactions = 0;
+    uint32_t bytes = 0;
+    bool realTime = false; //Each transaction takes as long as it would on the bus
+
+    alpha_emulated_chip_t *findChip(uint8_t address);
+    void countTransaction(uint8_t dataBytes);
+    void resetChip(alpha_emulated_chip_t *chip);
+
+public:
+    bool addDisplay(uint8_t address);
+    bool setConnected(uint8_t address, bool connected); //Unplug or plug in a display
+    void reset(); //Back to the power on state, the counters are kept
+
+    //Bus side, used by HT16K33 in place of the Wire port. Both return a Wire library result.
+    uint8_t transmit(uint8_t address, const uint8_t *data, uint8_t size);
+    uint8_t receive(uint8_t address, uint8_t *buff, uint8_t size);
+
+    //Bus time
+    void setBusClock(uint32_t clockHz);
+    void setRealTime(bool waitForBus);
+    uint32_t getBusMicros();
+    uint32_t getTransactions();
+    uint32_t getBytes();
+    void resetCounters();
+
+    //Chip state
+    const uint8_t *getRAM(uint8_t address);
+    bool isDisplayLit(uint8_t address);
+    uint8_t getDimming(uint8_t address);
+    uint8_t getBlinkRate(uint8_t address);
+    uint16_t getDigitSegments(uint8_t address, uint8_t digit);
+    bool setKey(uint8_t address, uint8_t key, bool pressed);
+
+    //Draw all displays side by side, five lines high
+    void render(Print &out);
+};
+
+#endif